@@ -1,37 +1,72 @@
-#ifndef OSAKA_H
-#define OSAKA_H
-
-#include <stdlib.h>
-#include <stdbool.h>
-
-#include "raylib.h"
-
-#define TITLE_CHARACTER_LENGTH 128
-#define PATH_CHARACTER_LENGTH 256
-
-#define RESOURCES_PATH "./data/resources/"
-
-#define ICON_FILE_NAME RESOURCES_PATH "icon.png"
-
-extern bool running;
-
-extern char NAME[TITLE_CHARACTER_LENGTH];
-extern int windowWidth;
-extern int windowHeight;
-
-#include "OSAKA_resources.h"
-
-void OSAKA_Run(char name[TITLE_CHARACTER_LENGTH], int width, int height, 
-               void (*init)(), void (*update)(), void (*render)(), void (*quit)());
-
-void OSAKA_Init(char name[TITLE_CHARACTER_LENGTH], int width, int height);
-
-void OSAKA_InitWindow(char name[TITLE_CHARACTER_LENGTH], int width, int height, 
-                      char fileName[PATH_CHARACTER_LENGTH]);
-					  
-void OSAKA_InitIcon(char fileName[PATH_CHARACTER_LENGTH]);
-void OSAKA_InitAudio();
-void OSAKA_MainLoop(void (*init)(), void (*update)(), void (*render)(), void (*quit)());
-void OSAKA_Quit(int exitCode);
-
+#ifndef OSAKA_H
+#define OSAKA_H
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "raylib.h"
+
+#define TITLE_CHARACTER_LENGTH 128
+#define PATH_CHARACTER_LENGTH 256
+
+#define RESOURCES_PATH "./data/resources/"
+
+#define ICON_FILE_NAME RESOURCES_PATH "icon.png"
+
+#define DEFAULT_TICK_RATE 60
+#define DEFAULT_RENDER_RATE 0		// frames per second render() is capped at, 0 leaves it to the display (vsync)
+#define MAX_TICKS_PER_FRAME 8		// stops a slow frame from snowballing into a slower one
+#define MAX_FRAME_TIME 0.25			// seconds, anything longer (dragging the window, breakpoints) is dropped
+
+extern bool running;
+
+extern char NAME[TITLE_CHARACTER_LENGTH];
+extern int windowWidth;
+extern int windowHeight;
+
+#include "OSAKA_resources.h"
+#include "OSAKA_spatial.h"
+#include "OSAKA_levels.h"
+#include "OSAKA_threads.h"
+#include "OSAKA_pack.h"
+#include "OSAKA_profiler.h"
+#include "OSAKA_input.h"
+#include "OSAKA_tilemap.h"
+#include "OSAKA_sprites.h"
+#include "OSAKA_text.h"
+#include "OSAKA_audio.h"
+
+void OSAKA_Run(char name[TITLE_CHARACTER_LENGTH], int width, int height, 
+               void (*init)(), void (*update)(), void (*render)(), void (*quit)());
+
+// no window, gl or audio, update() runs back to back until the tick count is reached (0 for no limit) or running is cleared
+void OSAKA_RunHeadless(void (*init)(), void (*update)(), void (*quit)(), long long ticks);
+
+void OSAKA_Init(char name[TITLE_CHARACTER_LENGTH], int width, int height);
+void OSAKA_InitHeadless();
+
+void OSAKA_InitWindow(char name[TITLE_CHARACTER_LENGTH], int width, int height, 
+                      char fileName[PATH_CHARACTER_LENGTH]);
+					  
+void OSAKA_InitIcon(char fileName[PATH_CHARACTER_LENGTH]);
+void OSAKA_InitAudio();
+void OSAKA_MainLoop(void (*init)(), void (*update)(), void (*render)(), void (*quit)());
+void OSAKA_HeadlessLoop(void (*init)(), void (*update)(), void (*quit)(), long long ticks);
+void OSAKA_Quit(int exitCode);
+
+// fixed timestep, update() runs at the tick rate and render() runs as often as the display allows
+void OSAKA_SetTickRate(int tickRate);
+int OSAKA_GetTickRate();
+float OSAKA_GetTickTime();
+void OSAKA_SetTimeScale(float timeScale);
+float OSAKA_GetTimeScale();
+float OSAKA_GetInterpolation();
+
+// 0 waits on vsync so render() keeps up with 144 and 240 hz displays, anything else turns vsync off and caps it there
+void OSAKA_SetRenderRate(int renderRate);
+int OSAKA_GetRenderRate();
+long long OSAKA_GetTickCount();
+
+bool OSAKA_IsHeadless();
+
 #endif /* OSAKA_H */
\ No newline at end of file
@@ -0,0 +1,43 @@
+#ifndef OSAKA_AUDIO_H
+#define OSAKA_AUDIO_H
+
+#define AUDIO_COMMANDS_LENGTH 64			// must be a power of two, commands that can wait for the audio thread at once
+#define AUDIO_UPDATE_INTERVAL 5000000		// nanoseconds between the audio thread's refills of the playing streams
+#define AUDIO_STREAM_BUFFER_FRAMES 4096		// each half of a music stream's buffer, a refill has to come round before one plays out
+
+// how far the music is decoded ahead of the mixer, worked out from the time between refills rather than asking it,
+// so these are the worst case, a half buffer finishing just after the refill before
+typedef struct MusicStats
+{
+	int playing;			// tracks being fed, fading ones included
+	int cued;				// decoded up to the end of their buffers and silent, ready to start without decoding anything
+	float ahead;			// seconds decoded ahead of the mixer after the last refill, in the emptiest playing track
+	float lowestAhead;		// the least there has been just before a refill, at or below 0 the music ran dry
+	long long underruns;
+	long long refills;		// of tracks already playing, lowestAhead means nothing until there is one
+} MusicStats;
+
+// music is fed by its own thread so a stalled frame never starves a stream, the game only queues commands
+// for it, every call below is for the main thread and never waits on the audio thread
+void OSAKA_PlayMusic(int index);			// carries on if it is already playing
+void OSAKA_StopMusic(int index);			// and rewinds it
+void OSAKA_SwitchMusic(int index);			// plays index and fades every other track out over the crossfade
+
+// rewinds a track and decodes its head into its buffers on the audio thread, so a later play or switch to it
+// starts straight out of them, does nothing to a track that is playing
+void OSAKA_CueMusic(int index);
+
+// seconds OSAKA_SwitchMusic fades over, 0 cuts straight over
+void OSAKA_SetMusicCrossfade(float seconds);
+float OSAKA_GetMusicCrossfade();
+
+MusicStats OSAKA_GetMusicStats();
+
+// waits until the audio thread has carried out every command queued so far, for before a track is unloaded
+void OSAKA_FlushAudio();
+
+// no thread is started headless and every command is dropped
+void OSAKA_InitAudioThread();
+void OSAKA_QuitAudio();
+
+#endif /* OSAKA_AUDIO_H */
@@ -0,0 +1,24 @@
+#ifndef OSAKA_FILES_H
+#define OSAKA_FILES_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+// a whole file, read only, mapped where the platform allows it and read into memory where it does not
+typedef struct MappedFile
+{
+	const void* data;
+	size_t size;
+	bool mapped;		// false when data was malloced and read in instead
+	
+#ifdef _WIN32
+	void* fileHandle;
+	void* mappingHandle;
+#endif
+} MappedFile;
+
+// kept apart from raylib so the platform headers can be included without name clashes, callers do the logging
+bool OSAKA_MapFile(MappedFile* file, const char* fileName);
+void OSAKA_UnmapFile(MappedFile* file);
+
+#endif /* OSAKA_FILES_H */
@@ -0,0 +1,64 @@
+#ifndef OSAKA_INPUT_H
+#define OSAKA_INPUT_H
+
+#include <stdint.h>
+
+#include "OSAKA_files.h"
+
+#define MOUSE_BUTTONS_LENGTH 7
+#define INPUT_KEYS_LENGTH 32		// distinct keys a game can ask about, one bit each in a tick's input
+
+#define REPLAY_MAGIC "OSKR"
+#define REPLAY_VERSION 1
+
+// on disk layout, little endian: header, runs of identical ticks, then the world hash after every tick
+typedef struct ReplayHeader
+{
+	char magic[4];
+	uint32_t version;
+	uint32_t tickRate;
+	uint32_t runsLength;
+	uint64_t ticksLength;
+	int32_t keys[INPUT_KEYS_LENGTH];	// raylib key codes in bit order, 0 for unused bits
+} ReplayHeader;
+
+// everything a tick can see, keys only has bits for keys the game asked about during the tick
+typedef struct InputTick
+{
+	uint32_t keys;
+	uint8_t mouseButtons;		// presses, one bit per raylib mouse button
+	uint8_t reserved[3];
+} InputTick;
+
+typedef struct ReplayRun
+{
+	InputTick input;
+	uint32_t length;
+} ReplayRun;
+
+// called by the main loop, presses are latched across frames until a tick consumes them
+void OSAKA_PollInput();
+void OSAKA_BeginTickInput();
+void OSAKA_EndTickInput();
+
+// gameplay input, only meaningful inside update(), anything read here is what gets recorded and replayed
+bool OSAKA_IsKeyDown(int key);
+bool OSAKA_IsMouseButtonPressed(int button);
+
+// hashed after every recorded or replayed tick so a replay can tell where it stopped matching
+void OSAKA_SetWorldHash(uint64_t (*hash)());
+
+// start before the first tick, the recording is written when it is stopped or the engine quits
+bool OSAKA_StartRecording(char fileName[PATH_CHARACTER_LENGTH]);
+bool OSAKA_StopRecording();
+bool OSAKA_IsRecording();
+
+// replaces live input until the replay runs out, running headless that ends the run
+bool OSAKA_StartReplay(char fileName[PATH_CHARACTER_LENGTH]);
+void OSAKA_StopReplay();
+bool OSAKA_IsReplaying();
+long long OSAKA_GetReplayDivergences();
+
+void OSAKA_QuitInput();
+
+#endif /* OSAKA_INPUT_H */
@@ -0,0 +1,76 @@
+#ifndef OSAKA_LEVELS_H
+#define OSAKA_LEVELS_H
+
+#include <stdint.h>
+
+#include "OSAKA_files.h"
+
+#define LEVEL_PACK_MAGIC "OSKL"
+#define LEVEL_PACK_VERSION 1
+#define LEVEL_PACK_ALIGNMENT 4
+
+// on disk layout, little endian, every offset is from the start of the file:
+// header, one entry per level, then each level's spawns, tiles and text
+typedef struct LevelPackHeader
+{
+	char magic[4];
+	uint32_t version;
+	uint32_t levelsLength;
+	uint32_t size;				// whole pack in bytes
+} LevelPackHeader;
+
+typedef struct LevelPackEntry
+{
+	uint16_t gridWidth, gridHeight;
+	uint32_t tilesOffset;		// gridWidth * gridHeight bytes, row major
+	uint32_t spawnsOffset;
+	uint32_t spawnsLength;
+	int32_t music;				// track to switch to, 0 to leave it playing
+	int32_t sound;				// played once the level is in, 0 for none
+	uint32_t textOffset;		// nul terminated, 0 for no text
+	int32_t textX, textY, textSize;
+	uint8_t textColor[4];
+} LevelPackEntry;
+
+// type and flags are up to the game
+typedef struct LevelSpawn
+{
+	int32_t type;
+	int32_t flags;
+	float x, y;
+	float width, height;
+	float scaleX, scaleY;
+} LevelSpawn;
+
+// a level as the game sees it, pointers go straight into the pack and stay valid until it is closed
+typedef struct Level
+{
+	int gridWidth, gridHeight;
+	const unsigned char* tiles;
+	const LevelSpawn* spawns;
+	int spawnsLength;
+	int music;
+	int sound;
+	const char* text;
+	int textX, textY, textSize;
+	Color textColor;
+} Level;
+
+typedef struct LevelPack
+{
+	MappedFile file;
+	const LevelPackEntry* entries;
+	int levelsLength;
+} LevelPack;
+
+// the whole pack is checked once here so getting a level is only pointer fix ups
+bool OSAKA_OpenLevelPack(LevelPack* pack, char fileName[PATH_CHARACTER_LENGTH]);
+bool OSAKA_OpenLevelPackFromMemory(LevelPack* pack, void* data, size_t size);	// takes ownership of malloced data
+void OSAKA_CloseLevelPack(LevelPack* pack);
+bool OSAKA_GetLevel(LevelPack* pack, int index, Level* level);
+
+// writes levels out in the pack layout, the returned buffer is malloced
+void* OSAKA_BuildLevelPack(const Level* levels, int levelsLength, size_t* size);
+bool OSAKA_SaveLevelPack(char fileName[PATH_CHARACTER_LENGTH], const Level* levels, int levelsLength);
+
+#endif /* OSAKA_LEVELS_H */
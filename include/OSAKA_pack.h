@@ -0,0 +1,59 @@
+#ifndef OSAKA_PACK_H
+#define OSAKA_PACK_H
+
+#include <stdint.h>
+
+#include "OSAKA_files.h"
+
+#define ASSET_PACK_MAGIC "OSKA"
+#define ASSET_PACK_VERSION 1
+#define ASSET_PACK_ALIGNMENT 64			// every asset starts on its own cache line
+#define ASSET_PACK_NAME_LENGTH 128
+#define ASSET_PACK_FILE_NAME RESOURCES_PATH "assets.oska"
+
+#define ASSET_TEXTURE 1		// pixels in the format the image decoded to, uploaded as is
+#define ASSET_SOUND 2		// pcm samples as LoadWave gives them
+#define ASSET_MUSIC 3		// the original file, music is streamed and decoded as it plays
+#define ASSET_FONT 4		// the original file
+
+// on disk layout, little endian: header, entries sorted by name, then the assets each aligned to ASSET_PACK_ALIGNMENT
+typedef struct AssetPackHeader
+{
+	char magic[4];
+	uint32_t version;
+	uint32_t entriesLength;
+	uint32_t reserved;
+	uint64_t size;
+} AssetPackHeader;
+
+typedef struct AssetPackEntry
+{
+	char name[ASSET_PACK_NAME_LENGTH];	// path under the packed directory, forward slashes
+	char extension[8];					// for the loaders that want to know the original file type
+	uint32_t type;
+	uint32_t reserved;
+	uint64_t offset;
+	uint64_t size;
+	
+	int32_t width, height, mipmaps, format;							// textures
+	uint32_t frameCount, sampleRate, sampleSize, channels;			// sounds
+} AssetPackEntry;
+
+typedef struct AssetPack
+{
+	MappedFile file;
+	const AssetPackEntry* entries;
+	int entriesLength;
+} AssetPack;
+
+bool OSAKA_OpenAssetPack(AssetPack* pack, char fileName[PATH_CHARACTER_LENGTH]);
+void OSAKA_CloseAssetPack(AssetPack* pack);
+
+// file names are looked up relative to RESOURCES_PATH, returns NULL when the pack does not have it
+const AssetPackEntry* OSAKA_FindAsset(AssetPack* pack, const char* fileName);
+const void* OSAKA_GetAssetData(AssetPack* pack, const AssetPackEntry* entry);
+
+// decodes every texture, sound, music and font file under directory and writes them into one pack
+bool OSAKA_SaveAssetPack(char fileName[PATH_CHARACTER_LENGTH], char directory[PATH_CHARACTER_LENGTH]);
+
+#endif /* OSAKA_PACK_H */
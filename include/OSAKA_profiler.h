@@ -0,0 +1,50 @@
+#ifndef OSAKA_PROFILER_H
+#define OSAKA_PROFILER_H
+
+#include <stdint.h>
+
+#define PROFILER_THREADS_LENGTH 32
+#define PROFILER_RECORDS_LENGTH 16384		// per thread, must be a power of two, older zones are overwritten
+#define PROFILER_DEPTH 32					// deepest nesting, deeper zones are not recorded
+#define PROFILER_ZONES_LENGTH 64			// distinct zone names shown in the overlay
+#define PROFILER_HISTORY_LENGTH 120			// frames the overlay averages and takes maxima over
+
+#define PROFILER_OVERLAY_KEY KEY_F4
+#define PROFILER_SAVE_KEY KEY_F5
+#define PROFILER_TRACE_FILE_NAME "profile.json"
+
+// zones nest and must end on the thread they began on, names must outlive the profiler (string literals)
+// build with OSAKA_NO_PROFILER to compile every zone out
+#ifndef OSAKA_NO_PROFILER
+	#define PROFILE_BEGIN(name) OSAKA_ProfileBegin(name)
+	#define PROFILE_END() OSAKA_ProfileEnd()
+#else
+	#define PROFILE_BEGIN(name) ((void)0)
+	#define PROFILE_END() ((void)0)
+#endif
+
+// one finished zone, what the ring buffers hold
+typedef struct ProfileRecord
+{
+	const char* name;
+	uint64_t start;
+	uint64_t end;
+	int depth;
+} ProfileRecord;
+
+void OSAKA_ProfileBegin(const char* name);
+void OSAKA_ProfileEnd();
+
+// rolls the main thread's zones since the last call into the overlay statistics, called once a frame by the main loop
+void OSAKA_ProfileFrame();
+
+void OSAKA_SetProfilerOverlay(bool visible);
+bool OSAKA_IsProfilerOverlayVisible();
+void OSAKA_DrawProfilerOverlay(int x, int y);
+
+// every zone still in the ring buffers, from every thread, as chrome trace event json (chrome://tracing, perfetto)
+bool OSAKA_SaveProfile(char fileName[PATH_CHARACTER_LENGTH]);
+
+void OSAKA_QuitProfiler();
+
+#endif /* OSAKA_PROFILER_H */
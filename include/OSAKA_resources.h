@@ -1,40 +1,98 @@
-#ifndef OSAKA_RESOURCES_H
-#define OSAKA_RESOURCES_H
-
-#define TEXTURES_LENGTH 64
-#define SOUNDS_LENGTH 32
-#define MUSIC_LENGTH 16
-#define FONTS_LENGTH 8
-
-#define TEXTURES_PATH RESOURCES_PATH "textures/"
-#define SOUNDS_PATH RESOURCES_PATH "sounds/"
-#define MUSIC_PATH RESOURCES_PATH "music/"
-#define FONTS_PATH RESOURCES_PATH "fonts/"
-
-#define MISSING_TEXTURE_FILE_NAME TEXTURES_PATH "missing.png"
-#define MISSING_SOUND_FILE_NAME SOUNDS_PATH "missing.wav"
-#define MISSING_MUSIC_FILE_NAME MUSIC_PATH "missing.mp3"
-#define MISSING_FONT_FILE_NAME FONTS_PATH "missing.ttf"
-
-extern Texture2D textures[TEXTURES_LENGTH];
-extern Sound sounds[SOUNDS_LENGTH];
-extern Music musicTracks[MUSIC_LENGTH];
-extern Font fonts[FONTS_LENGTH];
-
-int OSAKA_LoadTexture(char fileName[PATH_CHARACTER_LENGTH], int index);
-void OSAKA_UnloadTexture(int index);
-
-int OSAKA_LoadSound(char fileName[PATH_CHARACTER_LENGTH], int index);
-void OSAKA_UnloadSound(int index);
-
-int OSAKA_LoadMusic(char fileName[PATH_CHARACTER_LENGTH], int index);
-void OSAKA_UnloadMusic(int index);
-
-int OSAKA_LoadFont(char fileName[PATH_CHARACTER_LENGTH], int index);
-void OSAKA_UnloadFont(int index);
-
-void OSAKA_InitResources();
-
-void OSAKA_QuitResources();
-
+#ifndef OSAKA_RESOURCES_H
+#define OSAKA_RESOURCES_H
+
+#define TEXTURES_LENGTH 64
+#define SOUNDS_LENGTH 32
+#define SOUND_VOICES_LENGTH 4		// most copies of one sound that can play over each other
+#define SOUND_MIXER_VOICES 8		// most sounds playing at once, past that quieter ones are cut for more important ones
+#define MUSIC_LENGTH 16
+#define FONTS_LENGTH 8
+#define ATLAS_PAGES_LENGTH 4
+#define ATLAS_PAGE_SIZE 2048
+#define ATLAS_PADDING 2			// gap between packed textures so neighbours never bleed into each other
+#define ASYNC_LOADS_LENGTH 256		// loads that can be in flight at once
+#define ASYNC_LOAD_THREADS_LENGTH 8
+
+#define LOAD_STATE_QUEUED 1		// waiting for or being decoded on a worker
+#define LOAD_STATE_DECODED 2	// waiting for OSAKA_UpdateAsyncLoads to hand it over on the main thread
+#define LOAD_STATE_DONE 3
+#define LOAD_STATE_FAILED 4
+
+#define TEXTURES_PATH RESOURCES_PATH "textures/"
+#define SOUNDS_PATH RESOURCES_PATH "sounds/"
+#define MUSIC_PATH RESOURCES_PATH "music/"
+#define FONTS_PATH RESOURCES_PATH "fonts/"
+
+#define MISSING_TEXTURE_FILE_NAME TEXTURES_PATH "missing.png"
+#define MISSING_SOUND_FILE_NAME SOUNDS_PATH "missing.wav"
+#define MISSING_MUSIC_FILE_NAME MUSIC_PATH "missing.mp3"
+#define MISSING_FONT_FILE_NAME FONTS_PATH "missing.ttf"
+
+extern Texture2D textures[TEXTURES_LENGTH];
+extern Sound sounds[SOUNDS_LENGTH];
+extern Music musicTracks[MUSIC_LENGTH];
+extern Font fonts[FONTS_LENGTH];
+
+typedef struct SoundStats
+{
+	int voices;				// playing right now
+	long long merged;		// plays of a sound already started the same tick, not played again
+	long long stolen;		// plays that cut off an older voice to get one
+	long long dropped;		// plays with no voice to take, the mixer being full of more important ones
+} SoundStats;
+
+// where a texture ended up in the atlas, textures that are not packed draw from their own slot
+typedef struct AtlasRegion
+{
+	bool packed;
+	int page;
+	Rectangle source;
+} AtlasRegion;
+
+extern Texture2D atlasPages[ATLAS_PAGES_LENGTH];
+
+int OSAKA_LoadTexture(char fileName[PATH_CHARACTER_LENGTH], int index);
+void OSAKA_UnloadTexture(int index);
+
+int OSAKA_LoadSound(char fileName[PATH_CHARACTER_LENGTH], int index);
+void OSAKA_UnloadSound(int index);
+
+// each sound gets SOUND_VOICES_LENGTH voices (aliases sharing its samples) so plays overlap instead of restarting it,
+// plays in the same tick are merged, past its cap a sound restarts its oldest voice, and once SOUND_MIXER_VOICES
+// are playing the oldest voice of a sound with no higher priority is cut for it, or the play is dropped
+void OSAKA_PlaySound(int index);
+void OSAKA_SetSoundVoices(int index, int voices, int priority);
+long long OSAKA_GetSoundPlayCount(int index);		// every play asked for, merged or dropped or not
+SoundStats OSAKA_GetSoundStats();
+
+int OSAKA_LoadMusic(char fileName[PATH_CHARACTER_LENGTH], int index);
+void OSAKA_UnloadMusic(int index);
+
+int OSAKA_LoadFont(char fileName[PATH_CHARACTER_LENGTH], int index);
+void OSAKA_UnloadFont(int index);
+
+// registered textures are packed into as few atlas pages as possible by OSAKA_BuildAtlas, so draws
+// through OSAKA_DrawSprite share a texture and land in the same draw
+void OSAKA_AddToAtlas(int index);
+void OSAKA_BuildAtlas();
+void OSAKA_UnloadAtlas();
+Texture2D OSAKA_GetAtlasTexture(int index, Rectangle* source);
+
+// draws straight away, for the odd full screen picture, anything drawn often goes through OSAKA_DrawSprite
+void OSAKA_DrawTexture(int index, Rectangle dest, Color tint);
+
+// files are read and decoded on worker threads and handed over to textures[], sounds[] and musicTracks[]
+// on the main thread, returns a handle for OSAKA_GetLoadState or 0 if the load could not be queued
+int OSAKA_LoadTextureAsync(char fileName[PATH_CHARACTER_LENGTH], int index, int group);
+int OSAKA_LoadSoundAsync(char fileName[PATH_CHARACTER_LENGTH], int index, int group);
+int OSAKA_LoadMusicAsync(char fileName[PATH_CHARACTER_LENGTH], int index, int group);
+int OSAKA_GetLoadState(int handle);		// handles older than ASYNC_LOADS_LENGTH loads report LOAD_STATE_DONE
+bool OSAKA_IsGroupLoaded(int group);
+void OSAKA_WaitForGroup(int group);
+void OSAKA_UpdateAsyncLoads();			// called by the main loop every frame
+
+void OSAKA_InitResources();
+
+void OSAKA_QuitResources();
+
 #endif /* OSAKA_RESOURCES_H */
\ No newline at end of file
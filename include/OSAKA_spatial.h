@@ -0,0 +1,51 @@
+#ifndef OSAKA_SPATIAL_H
+#define OSAKA_SPATIAL_H
+
+#define SPATIAL_HASH_BUCKETS_LENGTH 1024	// must be a power of two
+#define SPATIAL_HASH_INSERTION_SORT_LENGTH 16	// query results up to this long are sorted in place, longer ones with qsort
+
+typedef struct SpatialHashEntry
+{
+	int id;
+	int cellX, cellY;
+} SpatialHashEntry;
+
+typedef struct SpatialHashBucket
+{
+	SpatialHashEntry* entries;
+	int length, capacity;
+} SpatialHashBucket;
+
+// cell range an id is currently stored in, inclusive
+typedef struct SpatialHashItem
+{
+	bool inserted;
+	int minX, minY, maxX, maxY;
+	unsigned int queryStamp;
+} SpatialHashItem;
+
+typedef struct SpatialHash
+{
+	float cellSize;
+	SpatialHashBucket buckets[SPATIAL_HASH_BUCKETS_LENGTH];
+
+	SpatialHashItem* items;
+	int itemsCapacity;
+
+	int* results;		// filled by OSAKA_QuerySpatialHash, valid until the next query
+	int resultsCapacity;
+	unsigned int queryStamp;
+} SpatialHash;
+
+void OSAKA_InitSpatialHash(SpatialHash* hash, float cellSize);
+void OSAKA_FreeSpatialHash(SpatialHash* hash);
+void OSAKA_ClearSpatialHash(SpatialHash* hash);
+
+// inserts the id or moves it to the cells under box, cheap when the cells have not changed
+void OSAKA_UpdateSpatialHash(SpatialHash* hash, int id, Rectangle box);
+void OSAKA_RemoveFromSpatialHash(SpatialHash* hash, int id);
+
+// ids whose cells touch the box, each once and in ascending order, returns the count
+int OSAKA_QuerySpatialHash(SpatialHash* hash, Rectangle box, int** results);
+
+#endif /* OSAKA_SPATIAL_H */
\ No newline at end of file
@@ -0,0 +1,35 @@
+#ifndef OSAKA_SPRITES_H
+#define OSAKA_SPRITES_H
+
+#define SPRITES_LENGTH 4096			// starting capacity of a batch, it doubles when a frame submits more
+#define SPRITE_LAYERS_LENGTH 256
+
+#define SPRITE_FLIP_X 1
+#define SPRITE_FLIP_Y 2
+
+// what the last finished frame cost, the main loop rolls these over every frame
+typedef struct SpriteStats
+{
+	int sprites;
+	int draws;			// runs of quads on one texture, what the gpu actually gets asked to draw
+	int binds;			// texture switches
+	int flushes;		// times rlgl's vertex buffer filled up and had to be drawn part way through
+} SpriteStats;
+
+// sprites are collected between OSAKA_BeginSprites and OSAKA_EndSprites, then drawn back to front by layer and
+// grouped by texture inside a layer, sprites with the same layer and texture keep the order they were submitted in
+void OSAKA_BeginSprites();
+
+// index is a texture slot, drawn from the atlas when it was packed, flip mirrors the texture coordinates
+void OSAKA_DrawSprite(int index, Rectangle dest, Color tint, int layer, int flip);
+void OSAKA_DrawSpriteTexture(Texture2D texture, Rectangle source, Rectangle dest, Color tint, int layer, int flip);
+
+// draws in whatever mode is current, so the camera has to still be on for world sprites
+void OSAKA_EndSprites();
+
+SpriteStats OSAKA_GetSpriteStats();
+void OSAKA_ResetSpriteStats();		// called by the main loop every frame
+
+void OSAKA_QuitSprites();
+
+#endif /* OSAKA_SPRITES_H */
@@ -0,0 +1,42 @@
+#ifndef OSAKA_TEXT_H
+#define OSAKA_TEXT_H
+
+#define TEXT_CHARACTER_LENGTH 512
+#define TEXT_LINE_GAP 2				// pixels between lines on top of the text size, same as raylib's DrawText
+
+// where one glyph sits relative to the text's position and where it comes from in the font texture
+typedef struct TextGlyph
+{
+	Rectangle source;
+	Rectangle dest;
+} TextGlyph;
+
+// text that is laid out once and kept, drawing it only hands the cached glyph quads to the sprite batch,
+// the layout is redone on the next draw after the string or the font in its slot changes
+typedef struct Text
+{
+	int font;				// slot in fonts[], raylib's default font is used while the slot is empty
+	float size;
+	float spacing;			// extra gap between glyphs, OSAKA_InitText sets the one DrawText would use
+	Color color;
+	int layer;
+	char string[TEXT_CHARACTER_LENGTH];
+
+	bool shaped;
+	unsigned int shapedTexture;		// font texture the glyphs were laid out against
+	TextGlyph glyphs[TEXT_CHARACTER_LENGTH];
+	int glyphsLength;
+	Vector2 bounds;
+} Text;
+
+void OSAKA_InitText(Text* text, int font, float size, Color color, int layer);
+
+// copies string in, returns false and keeps the layout when it is the same string
+bool OSAKA_SetText(Text* text, const char* string);
+
+// into the current sprite batch with the top left at x, y
+void OSAKA_DrawText(Text* text, float x, float y);
+
+Vector2 OSAKA_MeasureText(Text* text);
+
+#endif /* OSAKA_TEXT_H */
@@ -0,0 +1,42 @@
+#ifndef OSAKA_THREADS_H
+#define OSAKA_THREADS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define JOB_POOL_THREADS_LENGTH 16
+
+// kept apart from raylib so the platform headers can be included without name clashes, like OSAKA_files
+typedef struct Mutex Mutex;
+typedef struct Condition Condition;
+typedef struct Thread Thread;
+typedef struct JobPool JobPool;
+
+Mutex* OSAKA_CreateMutex();
+void OSAKA_DestroyMutex(Mutex* mutex);
+void OSAKA_LockMutex(Mutex* mutex);
+void OSAKA_UnlockMutex(Mutex* mutex);
+
+Condition* OSAKA_CreateCondition();
+void OSAKA_DestroyCondition(Condition* condition);
+void OSAKA_WaitCondition(Condition* condition, Mutex* mutex);
+void OSAKA_SignalCondition(Condition* condition);
+void OSAKA_BroadcastCondition(Condition* condition);
+
+Thread* OSAKA_CreateThread(void (*function)(void* data), void* data);
+void OSAKA_JoinThread(Thread* thread);
+
+int OSAKA_GetProcessorCount();
+
+// monotonic, only differences between two calls mean anything
+uint64_t OSAKA_GetTimeNanoseconds();
+void OSAKA_SleepNanoseconds(uint64_t nanoseconds);
+
+// a fixed set of worker threads taking jobs first in first out
+JobPool* OSAKA_CreateJobPool(int threadsLength);
+bool OSAKA_PushJob(JobPool* pool, void (*job)(void* data), void* data);
+void OSAKA_WaitJobPool(JobPool* pool);			// until every pushed job has finished
+void OSAKA_DestroyJobPool(JobPool* pool);		// finishes the queued jobs first
+int OSAKA_GetJobPoolThreads(JobPool* pool);
+
+#endif /* OSAKA_THREADS_H */
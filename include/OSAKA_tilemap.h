@@ -0,0 +1,63 @@
+#ifndef OSAKA_TILEMAP_H
+#define OSAKA_TILEMAP_H
+
+#define TILEMAP_CHUNK_SIZE 32				// cells along each side of a chunk
+#define TILEMAP_CHUNK_CELLS (TILEMAP_CHUNK_SIZE * TILEMAP_CHUNK_SIZE)
+#define TILEMAP_EVICT_STREAMS 120			// streams a clean chunk can go untouched before it is dropped
+#define TILEMAP_RELEASE_DRAWS 60			// draws a baked chunk can stay out of view before its texture is released
+
+typedef struct TilemapChunk
+{
+	unsigned char tiles[TILEMAP_CHUNK_CELLS];
+	long long lastUsed;		// stream count when it was last read, written or inside the streamed area
+	bool dirty;				// changed since it was loaded, kept since the source no longer matches it
+	
+	RenderTexture2D baked;	// the chunk's cells drawn once, made by the first draw that sees it
+	bool stale;				// changed since it was baked
+	long long lastDrawn;	// draw count when it was last in view
+} TilemapChunk;
+
+// a changed chunk, all that has to be kept of a map to put it back since the rest is still in its source
+typedef struct TilemapEdit
+{
+	int chunk;				// index in chunks
+	unsigned char tiles[TILEMAP_CHUNK_CELLS];
+} TilemapEdit;
+
+// cells are loaded a chunk at a time from source the first time anything touches them and dropped again
+// once they go unused, so memory follows what is being looked at and collided with rather than the world size
+typedef struct Tilemap
+{
+	int width, height;				// cells
+	int tileSize;
+	int chunksWidth, chunksHeight;
+	TilemapChunk** chunks;			// chunksWidth * chunksHeight, NULL until loaded
+	int chunksLoaded;
+
+	const unsigned char* source;	// width * height row major, usually straight out of a mapped level pack, NULL for all empty
+	long long streams;
+	long long draws;
+} Tilemap;
+
+bool OSAKA_InitTilemap(Tilemap* map, int width, int height, int tileSize, const unsigned char* source);
+void OSAKA_FreeTilemap(Tilemap* map);
+
+// cells outside the map read as 0 and ignore writes
+unsigned char OSAKA_GetTile(Tilemap* map, int x, int y);
+void OSAKA_SetTile(Tilemap* map, int x, int y, unsigned char tile);
+
+// copies every changed chunk into edits, returns how many there are, call with NULL to count them
+int OSAKA_SaveTilemapEdits(Tilemap* map, TilemapEdit* edits);
+
+// puts the map back to its source and then the edits over it, a failed load leaves the map as it was
+bool OSAKA_LoadTilemapEdits(Tilemap* map, const TilemapEdit* edits, int editsLength);
+
+// loads every chunk under area (world units) ahead of use and drops clean chunks left untouched for TILEMAP_EVICT_STREAMS calls
+void OSAKA_StreamTilemap(Tilemap* map, Rectangle area);
+
+// submits one quad per chunk in view to the sprite batch on layer, chunks are baked with each tile value drawn with the
+// texture at tileTextures[value] and only baked again once their tiles change, so tileTextures should not change either,
+// baking leaves texture mode which resets the camera, so it is begun again with camera afterwards
+void OSAKA_DrawTilemap(Tilemap* map, Camera2D camera, int screenWidth, int screenHeight, const int* tileTextures, int tileTexturesLength, int layer);
+
+#endif /* OSAKA_TILEMAP_H */
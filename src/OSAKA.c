@@ -1,112 +1,323 @@
-#include "OSAKA.h"
-
-bool running;
-
-char NAME[TITLE_CHARACTER_LENGTH];
-int windowWidth;
-int windowHeight;
-
-void OSAKA_Run(char name[TITLE_CHARACTER_LENGTH], int width, int height, void (*init)(), void (*update)(), void (*render)(), void (*quit)())
-{
-	OSAKA_Init(name, width, height);
-	
-	OSAKA_MainLoop(init, update, render, quit);
-	
-	OSAKA_Quit(0);
-}
-
-void OSAKA_Init(char name[TITLE_CHARACTER_LENGTH], int width, int height)
-{
-	TraceLog(LOG_INFO, "initialising OSAKA engine, AMERICA YA :D !");
-	
-	OSAKA_InitWindow(name, width, height, ICON_FILE_NAME);
-	
-	OSAKA_InitAudio();
-	
-	OSAKA_InitResources();
-	
-	// misc
-	SetExitKey(0);
-	SetTargetFPS(60);
-	
-	TraceLog(LOG_INFO, "successfully initialised OSAKA engine, HALLO :D ! HALLO :D ! HALLO :D !");
-}
-
-void OSAKA_InitWindow(char name[TITLE_CHARACTER_LENGTH], int width, int height, char fileName[PATH_CHARACTER_LENGTH])
-{
-    InitWindow(width, height, name);
-
-	(IsWindowReady()) ?
-		TraceLog(LOG_INFO, "successfully initialised window") :
-		TraceLog(LOG_FATAL, "failed to initialise window, quitting...");
-		
-	windowWidth = width;
-	windowHeight = height;
-	
-	OSAKA_InitIcon(fileName);
-}
-
-void OSAKA_InitIcon(char fileName[PATH_CHARACTER_LENGTH])
-{
-	Image icon = LoadImage(fileName);
-	
-	if (icon.data)
-	{
-		SetWindowIcon(icon);
-		UnloadImage(icon);
-		
-		TraceLog(LOG_INFO, "succesfully loaded icon (icon file name : %s)", ICON_FILE_NAME);
-	}
-	else
-	{
-		TraceLog(LOG_ERROR, "failed to load icon (icon file name : %s)", ICON_FILE_NAME);
-	}
-}
-
-void OSAKA_InitAudio()
-{
-	InitAudioDevice();
-	
-	(IsAudioDeviceReady()) ?
-		TraceLog(LOG_INFO, "successfully initialised audio device") :
-		TraceLog(LOG_FATAL, "failed to initialise device, quitting...");
-}
-
-void OSAKA_MainLoop(void (*init)(), void (*update)(), void (*render)(), void (*quit)())
-{
-	init();
-	
-	running = true;
-	
-	while (running)
-	{	
-		running = !WindowShouldClose();
-		
-		
-		update();
-		
-		BeginDrawing();
-		ClearBackground(BLACK);
-		
-		render();
-		
-		EndDrawing();
-	}
-	
-	quit();
-}
-
-void OSAKA_Quit(int exitCode)
-{
-	TraceLog(LOG_INFO, "quitting OSAKA engine, BYE BYE :D !");
-	
-	OSAKA_QuitResources();
-
-	CloseAudioDevice();
-	
-	CloseWindow();
-	
-	TraceLog(LOG_INFO, "successfully quitted OSAKA engine, BYE BYE :D !");
-	
-	exit(exitCode);
-}
+#include "OSAKA.h"
+#include <math.h>
+
+bool running;
+
+char NAME[TITLE_CHARACTER_LENGTH];
+int windowWidth;
+int windowHeight;
+
+static int tickRate = DEFAULT_TICK_RATE;
+static int renderRate = DEFAULT_RENDER_RATE;
+static float timeScale = 1.0f;
+static float interpolation;
+static long long tickCount;
+
+static bool headless;
+
+void OSAKA_Run(char name[TITLE_CHARACTER_LENGTH], int width, int height, void (*init)(), void (*update)(), void (*render)(), void (*quit)())
+{
+	OSAKA_Init(name, width, height);
+	
+	OSAKA_MainLoop(init, update, render, quit);
+	
+	OSAKA_Quit(0);
+}
+
+void OSAKA_RunHeadless(void (*init)(), void (*update)(), void (*quit)(), long long ticks)
+{
+	OSAKA_InitHeadless();
+	
+	OSAKA_HeadlessLoop(init, update, quit, ticks);
+	
+	// a replay that stopped matching fails the run so scripts can catch it
+	OSAKA_Quit(OSAKA_GetReplayDivergences() ? 1 : 0);
+}
+
+static void applyRenderRate()
+{
+	if (renderRate) ClearWindowState(FLAG_VSYNC_HINT);
+	else SetWindowState(FLAG_VSYNC_HINT);
+	
+	SetTargetFPS(renderRate);
+}
+
+void OSAKA_Init(char name[TITLE_CHARACTER_LENGTH], int width, int height)
+{
+	TraceLog(LOG_INFO, "initialising OSAKA engine, AMERICA YA :D !");
+	
+	OSAKA_InitWindow(name, width, height, ICON_FILE_NAME);
+	
+	OSAKA_InitAudio();
+	
+	OSAKA_InitResources();
+	
+	// misc
+	SetExitKey(0);
+	applyRenderRate();
+	
+	TraceLog(LOG_INFO, "successfully initialised OSAKA engine, HALLO :D ! HALLO :D ! HALLO :D !");
+}
+
+void OSAKA_InitHeadless()
+{
+	TraceLog(LOG_INFO, "initialising OSAKA engine headless, AMERICA YA :D !");
+	
+	headless = true;
+	
+	TraceLog(LOG_INFO, "successfully initialised OSAKA engine headless, HALLO :D !");
+}
+
+void OSAKA_InitWindow(char name[TITLE_CHARACTER_LENGTH], int width, int height, char fileName[PATH_CHARACTER_LENGTH])
+{
+    InitWindow(width, height, name);
+
+	(IsWindowReady()) ?
+		TraceLog(LOG_INFO, "successfully initialised window") :
+		TraceLog(LOG_FATAL, "failed to initialise window, quitting...");
+		
+	windowWidth = width;
+	windowHeight = height;
+	
+	OSAKA_InitIcon(fileName);
+}
+
+void OSAKA_InitIcon(char fileName[PATH_CHARACTER_LENGTH])
+{
+	Image icon = LoadImage(fileName);
+	
+	if (icon.data)
+	{
+		SetWindowIcon(icon);
+		UnloadImage(icon);
+		
+		TraceLog(LOG_INFO, "succesfully loaded icon (icon file name : %s)", ICON_FILE_NAME);
+	}
+	else
+	{
+		TraceLog(LOG_ERROR, "failed to load icon (icon file name : %s)", ICON_FILE_NAME);
+	}
+}
+
+void OSAKA_InitAudio()
+{
+	InitAudioDevice();
+	
+	(IsAudioDeviceReady()) ?
+		TraceLog(LOG_INFO, "successfully initialised audio device") :
+		TraceLog(LOG_FATAL, "failed to initialise device, quitting...");
+	
+	OSAKA_InitAudioThread();
+}
+
+void OSAKA_MainLoop(void (*init)(), void (*update)(), void (*render)(), void (*quit)())
+{
+	init();
+	
+	running = true;
+	
+	double previousTime = GetTime();
+	double accumulator = 0;
+	
+	while (running)
+	{	
+		PROFILE_BEGIN("frame");
+		
+		running = !WindowShouldClose();
+		
+		if (IsKeyPressed(PROFILER_OVERLAY_KEY)) OSAKA_SetProfilerOverlay(!OSAKA_IsProfilerOverlayVisible());
+		if (IsKeyPressed(PROFILER_SAVE_KEY)) OSAKA_SaveProfile(PROFILER_TRACE_FILE_NAME);
+		
+		double currentTime = GetTime();
+		double frameTime = currentTime - previousTime;
+		previousTime = currentTime;
+		
+		if (frameTime > MAX_FRAME_TIME) frameTime = MAX_FRAME_TIME;
+		
+		accumulator += frameTime * timeScale;
+		
+		// presses are latched until a tick consumes them, otherwise frames with no tick would drop them
+		OSAKA_PollInput();
+		
+		PROFILE_BEGIN("async loads");
+		OSAKA_UpdateAsyncLoads();
+		PROFILE_END();
+		
+		double tickTime = 1.0 / tickRate;
+		int maxTicks = MAX_TICKS_PER_FRAME * (timeScale > 1 ? (int)ceilf(timeScale) : 1);
+		int ticks = 0;
+		
+		while (accumulator >= tickTime && ticks < maxTicks)
+		{
+			PROFILE_BEGIN("update");
+			OSAKA_BeginTickInput();
+			update();
+			OSAKA_EndTickInput();
+			PROFILE_END();
+			
+			accumulator -= tickTime;
+			ticks++;
+			tickCount++;
+		}
+		
+		// too far behind to catch up, drop the backlog instead of spiralling
+		if (accumulator >= tickTime) accumulator = fmod(accumulator, tickTime);
+		
+		interpolation = accumulator / tickTime;
+		
+		OSAKA_ResetSpriteStats();
+		
+		BeginDrawing();
+		ClearBackground(BLACK);
+		
+		PROFILE_BEGIN("render");
+		render();
+		PROFILE_END();
+		
+		OSAKA_DrawProfilerOverlay(10, 10);
+		
+		// includes the swap and the wait for the target fps
+		PROFILE_BEGIN("EndDrawing");
+		EndDrawing();
+		PROFILE_END();
+		
+		PROFILE_END();
+		
+		OSAKA_ProfileFrame();
+	}
+	
+	quit();
+}
+
+void OSAKA_HeadlessLoop(void (*init)(), void (*update)(), void (*quit)(), long long ticks)
+{
+	init();
+	
+	running = true;
+	
+	uint64_t start = OSAKA_GetTimeNanoseconds();
+	long long startTick = tickCount;
+	
+	while (running && (!ticks || tickCount - startTick < ticks))
+	{
+		PROFILE_BEGIN("update");
+		OSAKA_BeginTickInput();
+		update();
+		OSAKA_EndTickInput();
+		PROFILE_END();
+		
+		tickCount++;
+	}
+	
+	double elapsed = (OSAKA_GetTimeNanoseconds() - start) / 1000000000.0;
+	long long ran = tickCount - startTick;
+	
+	TraceLog(LOG_INFO, "headless run finished (ticks : %lld) (seconds : %.3f) (ticks per second : %.0f)",
+		ran, elapsed, elapsed > 0 ? ran / elapsed : 0);
+	
+	quit();
+}
+
+void OSAKA_Quit(int exitCode)
+{
+	TraceLog(LOG_INFO, "quitting OSAKA engine, BYE BYE :D !");
+	
+	OSAKA_QuitInput();
+	
+	OSAKA_QuitSprites();
+	
+	// before the tracks it feeds are unloaded
+	OSAKA_QuitAudio();
+	
+	OSAKA_QuitResources();
+	
+	OSAKA_QuitProfiler();
+
+	if (!headless)
+	{
+		CloseAudioDevice();
+		
+		CloseWindow();
+	}
+	
+	TraceLog(LOG_INFO, "successfully quitted OSAKA engine, BYE BYE :D !");
+	
+	exit(exitCode);
+}
+
+
+// timestep ------------------------------------------------------------------------------------------------------------
+
+void OSAKA_SetTickRate(int rate)
+{
+	if (rate <= 0)
+	{
+		TraceLog(LOG_ERROR, "could not set tick rate, tick rate must be positive (tick rate : %i)", rate);
+		return;
+	}
+	
+	tickRate = rate;
+	TraceLog(LOG_INFO, "set tick rate (tick rate : %i)", rate);
+}
+
+int OSAKA_GetTickRate()
+{
+	return tickRate;
+}
+
+void OSAKA_SetRenderRate(int rate)
+{
+	if (rate < 0)
+	{
+		TraceLog(LOG_ERROR, "could not set render rate, render rate must not be negative (render rate : %i)", rate);
+		return;
+	}
+	
+	renderRate = rate;
+	TraceLog(LOG_INFO, "set render rate (render rate : %i)", rate);
+	
+	// set before the window opens it is applied by OSAKA_Init
+	if (!headless && IsWindowReady()) applyRenderRate();
+}
+
+int OSAKA_GetRenderRate()
+{
+	return renderRate;
+}
+
+float OSAKA_GetTickTime()
+{
+	return 1.0f / tickRate;
+}
+
+void OSAKA_SetTimeScale(float scale)
+{
+	if (scale < 0)
+	{
+		TraceLog(LOG_ERROR, "could not set time scale, time scale must not be negative (time scale : %.2f)", scale);
+		return;
+	}
+	
+	timeScale = scale;
+	TraceLog(LOG_INFO, "set time scale (time scale : %.2f)", scale);
+}
+
+float OSAKA_GetTimeScale()
+{
+	return timeScale;
+}
+
+float OSAKA_GetInterpolation()
+{
+	return interpolation;
+}
+
+long long OSAKA_GetTickCount()
+{
+	return tickCount;
+}
+
+bool OSAKA_IsHeadless()
+{
+	return headless;
+}
\ No newline at end of file
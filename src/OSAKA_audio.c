@@ -0,0 +1,368 @@
+#include "OSAKA.h"
+
+// one producer (the main thread) and one consumer (the audio thread), so the queue only needs its two indices
+// published in order and never takes a lock
+#if defined(_MSC_VER)
+	#define ATOMIC_LOAD(value) (value)				// msvc volatile accesses already acquire and release
+	#define ATOMIC_STORE(value, x) ((value) = (x))
+#else
+	#define ATOMIC_LOAD(value) __atomic_load_n(&(value), __ATOMIC_ACQUIRE)
+	#define ATOMIC_STORE(value, x) __atomic_store_n(&(value), (x), __ATOMIC_RELEASE)
+#endif
+
+#define COMMANDS_MASK (AUDIO_COMMANDS_LENGTH - 1)
+
+#define AUDIO_COMMAND_PLAY 0
+#define AUDIO_COMMAND_STOP 1
+#define AUDIO_COMMAND_SWITCH 2
+#define AUDIO_COMMAND_CUE 3
+
+#define TRACK_STOPPED 0
+#define TRACK_CUED 1
+#define TRACK_PLAYING 2
+
+typedef struct AudioCommand
+{
+	int type;
+	int index;
+	Music music;			// copied out of musicTracks on the main thread, the audio thread never reads the slots
+	float seconds;			// to fade over
+} AudioCommand;
+
+typedef struct AudioTrack
+{
+	Music music;
+	int state;
+	float volume;
+	float target;			// volume being faded to, the track stops once it fades out
+	float rate;				// volume per second
+	bool fed;				// refilled at least once since it started, so the time since the last refill is its own
+} AudioTrack;
+
+static AudioCommand commands[AUDIO_COMMANDS_LENGTH];
+static volatile uint32_t commandsHead;		// commands ever pushed, only the main thread writes it
+static volatile uint32_t commandsTail;		// commands ever carried out, only the audio thread writes it
+
+static Thread* audioThread;
+static volatile long audioRunning;
+static float crossfade;
+
+// only ever touched by the audio thread while it runs
+static AudioTrack tracks[MUSIC_LENGTH];
+
+// written by the audio thread a field at a time, good enough to show, microseconds for the times
+static volatile long statsPlaying;
+static volatile long statsCued;
+static volatile long statsAhead;
+static volatile long statsLowestAhead;
+static volatile long long statsUnderruns;
+static volatile long long statsRefills;
+
+static void pushCommand(int type, int index)
+{
+	if (!audioThread) return;
+	
+	if (index < 0 || index >= MUSIC_LENGTH)
+	{
+		TraceLog(LOG_ERROR, "could not queue music command, index out of bounds (index : %i) (music length : %i)", index, MUSIC_LENGTH);
+		return;
+	}
+	
+	uint32_t head = commandsHead;
+	
+	if (head - ATOMIC_LOAD(commandsTail) == AUDIO_COMMANDS_LENGTH)
+	{
+		TraceLog(LOG_WARNING, "dropped music command, audio thread is behind (index : %i) (commands length : %i)", index, AUDIO_COMMANDS_LENGTH);
+		return;
+	}
+	
+	AudioCommand* command = &commands[head & COMMANDS_MASK];
+	
+	command->type = type;
+	command->index = index;
+	command->music = musicTracks[index];
+	command->seconds = crossfade;
+	
+	// the command is written before the head that hands it over
+	ATOMIC_STORE(commandsHead, head + 1);
+}
+
+// stopping rewinds the decoder and empties the buffers, the refill straight after decodes the head of the track
+// into both halves without it being heard, which is all the work starting a track ever takes
+static void cueTrack(AudioTrack* track)
+{
+	StopMusicStream(track->music);
+	SetMusicVolume(track->music, 0);
+	UpdateMusicStream(track->music);
+	
+	track->state = TRACK_CUED;
+	track->volume = 0;
+}
+
+static void fadeTrack(AudioTrack* track, float target, float seconds)
+{
+	track->target = target;
+	track->rate = seconds > 0 ? 1 / seconds : 0;
+	
+	if (seconds > 0) return;
+	
+	track->volume = target;
+	SetMusicVolume(track->music, target);
+}
+
+static void stopTrack(AudioTrack* track)
+{
+	if (track->state != TRACK_STOPPED) StopMusicStream(track->music);
+	
+	*track = (AudioTrack){0};
+}
+
+static void startTrack(AudioTrack* track, Music music, float seconds)
+{
+	if (!music.frameCount) return;
+	
+	// not cued ahead, its head is decoded here instead, still on this thread rather than the game's
+	if (track->state == TRACK_STOPPED)
+	{
+		track->music = music;
+		cueTrack(track);
+	}
+	
+	if (track->state == TRACK_CUED)
+	{
+		PlayMusicStream(track->music);
+		
+		track->state = TRACK_PLAYING;
+		track->fed = false;
+	}
+	
+	// a track that was fading out fades back in from where it got to
+	fadeTrack(track, 1, seconds);
+}
+
+static void runCommand(AudioCommand* command)
+{
+	AudioTrack* track = &tracks[command->index];
+	
+	switch (command->type)
+	{
+		case AUDIO_COMMAND_PLAY:
+			startTrack(track, command->music, 0);
+			break;
+			
+		case AUDIO_COMMAND_STOP:
+			stopTrack(track);
+			break;
+			
+		case AUDIO_COMMAND_SWITCH:
+			for (int i = 0; i < MUSIC_LENGTH; i++)
+			{
+				if (i == command->index || tracks[i].state != TRACK_PLAYING) continue;
+				
+				if (command->seconds > 0) fadeTrack(&tracks[i], 0, command->seconds);
+				else stopTrack(&tracks[i]);
+			}
+			
+			startTrack(track, command->music, command->seconds);
+			break;
+			
+		case AUDIO_COMMAND_CUE:
+			if (track->state != TRACK_STOPPED || !command->music.frameCount) break;
+			
+			track->music = command->music;
+			cueTrack(track);
+			break;
+	}
+}
+
+static void refillTracks(float seconds)
+{
+	int playing = 0;
+	int cued = 0;
+	float ahead = -1;
+	
+	for (int i = 0; i < MUSIC_LENGTH; i++)
+	{
+		AudioTrack* track = &tracks[i];
+		
+		if (track->state == TRACK_CUED) cued++;
+		if (track->state != TRACK_PLAYING) continue;
+		
+		if (track->volume != track->target)
+		{
+			float step = track->rate * seconds;
+			
+			if (track->volume < track->target) track->volume = track->volume + step < track->target ? track->volume + step : track->target;
+			else track->volume = track->volume - step > track->target ? track->volume - step : track->target;
+			
+			SetMusicVolume(track->music, track->volume);
+		}
+		
+		// faded out, cued again straight away so going back to it is as quick as the first time
+		if (track->target <= 0 && track->volume <= 0)
+		{
+			cueTrack(track);
+			cued++;
+			continue;
+		}
+		
+		if (track->fed && track->music.stream.sampleRate)
+		{
+			// a half buffer can finish just after a refill, so the other half is all there is to last until this one
+			float half = (float)AUDIO_STREAM_BUFFER_FRAMES / track->music.stream.sampleRate;
+			long lowest = (long)((half - seconds) * 1000000);
+			
+			if (ATOMIC_LOAD(statsRefills) == 0 || lowest < ATOMIC_LOAD(statsLowestAhead)) ATOMIC_STORE(statsLowestAhead, lowest);
+			if (lowest <= 0) ATOMIC_STORE(statsUnderruns, statsUnderruns + 1);
+			
+			ATOMIC_STORE(statsRefills, statsRefills + 1);
+			
+			if (ahead < 0 || 2 * half - seconds < ahead) ahead = 2 * half - seconds;
+		}
+		
+		UpdateMusicStream(track->music);
+		track->fed = true;
+		playing++;
+	}
+	
+	ATOMIC_STORE(statsPlaying, playing);
+	ATOMIC_STORE(statsCued, cued);
+	ATOMIC_STORE(statsAhead, ahead < 0 ? 0 : (long)(ahead * 1000000));
+}
+
+static void audioThreadMain(void* data)
+{
+	(void)data;		// everything it needs is in this file
+	
+	uint64_t previous = OSAKA_GetTimeNanoseconds();
+	
+	while (ATOMIC_LOAD(audioRunning))
+	{
+		uint64_t start = OSAKA_GetTimeNanoseconds();
+		
+		PROFILE_BEGIN("audio");
+		
+		uint32_t tail = commandsTail;
+		uint32_t head = ATOMIC_LOAD(commandsHead);
+		
+		for (; tail != head; tail++)
+		{
+			runCommand(&commands[tail & COMMANDS_MASK]);
+		}
+		
+		// the slots are only given back once the commands in them are done with
+		ATOMIC_STORE(commandsTail, tail);
+		
+		refillTracks((start - previous) / 1000000000.0f);
+		previous = start;
+		
+		PROFILE_END();
+		
+		uint64_t elapsed = OSAKA_GetTimeNanoseconds() - start;
+		
+		if (elapsed < AUDIO_UPDATE_INTERVAL) OSAKA_SleepNanoseconds(AUDIO_UPDATE_INTERVAL - elapsed);
+	}
+}
+
+void OSAKA_PlayMusic(int index)
+{
+	pushCommand(AUDIO_COMMAND_PLAY, index);
+}
+
+void OSAKA_StopMusic(int index)
+{
+	pushCommand(AUDIO_COMMAND_STOP, index);
+}
+
+void OSAKA_SwitchMusic(int index)
+{
+	pushCommand(AUDIO_COMMAND_SWITCH, index);
+}
+
+void OSAKA_CueMusic(int index)
+{
+	pushCommand(AUDIO_COMMAND_CUE, index);
+}
+
+void OSAKA_SetMusicCrossfade(float seconds)
+{
+	if (seconds < 0)
+	{
+		TraceLog(LOG_ERROR, "could not set music crossfade, crossfade must not be negative (seconds : %.2f)", seconds);
+		return;
+	}
+	
+	crossfade = seconds;
+}
+
+float OSAKA_GetMusicCrossfade()
+{
+	return crossfade;
+}
+
+MusicStats OSAKA_GetMusicStats()
+{
+	MusicStats stats;
+	
+	stats.playing = ATOMIC_LOAD(statsPlaying);
+	stats.cued = ATOMIC_LOAD(statsCued);
+	stats.ahead = ATOMIC_LOAD(statsAhead) / 1000000.0f;
+	stats.lowestAhead = ATOMIC_LOAD(statsLowestAhead) / 1000000.0f;
+	stats.underruns = ATOMIC_LOAD(statsUnderruns);
+	stats.refills = ATOMIC_LOAD(statsRefills);
+	
+	return stats;
+}
+
+void OSAKA_FlushAudio()
+{
+	if (!audioThread) return;
+	
+	while (ATOMIC_LOAD(commandsTail) != commandsHead)
+	{
+		OSAKA_SleepNanoseconds(AUDIO_UPDATE_INTERVAL / 4);
+	}
+}
+
+void OSAKA_InitAudioThread()
+{
+	if (OSAKA_IsHeadless() || audioThread) return;
+	
+	// every music stream loaded from here on gets buffers this big, which is what the buffer levels are worked out from
+	SetAudioStreamBufferSizeDefault(AUDIO_STREAM_BUFFER_FRAMES);
+	
+	ATOMIC_STORE(audioRunning, 1);
+	audioThread = OSAKA_CreateThread(audioThreadMain, NULL);
+	
+	if (!audioThread)
+	{
+		ATOMIC_STORE(audioRunning, 0);
+		TraceLog(LOG_ERROR, "failed to start audio thread, music will not play");
+		return;
+	}
+	
+	TraceLog(LOG_INFO, "successfully started audio thread (interval : %.1f ms)", AUDIO_UPDATE_INTERVAL / 1000000.0);
+}
+
+void OSAKA_QuitAudio()
+{
+	if (!audioThread) return;
+	
+	ATOMIC_STORE(audioRunning, 0);
+	OSAKA_JoinThread(audioThread);
+	audioThread = NULL;
+	
+	// the thread is gone so the streams can be stopped from here before they are unloaded
+	for (int i = 0; i < MUSIC_LENGTH; i++)
+	{
+		stopTrack(&tracks[i]);
+	}
+	
+	commandsHead = commandsTail = 0;
+	
+	MusicStats stats = OSAKA_GetMusicStats();
+	
+	if (stats.refills) TraceLog(LOG_INFO, "music buffers (lowest ahead : %.1f ms) (underruns : %lld) (refills : %lld)", stats.lowestAhead * 1000, stats.underruns, stats.refills);
+	
+	TraceLog(LOG_INFO, "successfully stopped audio thread");
+}
@@ -0,0 +1,132 @@
+#include "OSAKA_files.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(_WIN32)
+	#define WIN32_LEAN_AND_MEAN
+	#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+	#define OSAKA_FILES_MMAP
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+#endif
+
+// fallback for anything that cannot be mapped, including empty files which mmap refuses
+static bool readFile(MappedFile* file, const char* fileName)
+{
+	FILE* stream = fopen(fileName, "rb");
+	
+	if (!stream) return false;
+	
+	fseek(stream, 0, SEEK_END);
+	long size = ftell(stream);
+	fseek(stream, 0, SEEK_SET);
+	
+	if (size < 0)
+	{
+		fclose(stream);
+		return false;
+	}
+	
+	void* data = malloc(size ? size : 1);
+	
+	if (!data || fread(data, 1, size, stream) != (size_t)size)
+	{
+		free(data);
+		fclose(stream);
+		return false;
+	}
+	
+	fclose(stream);
+	
+	file->data = data;
+	file->size = size;
+	file->mapped = false;
+	
+	return true;
+}
+
+bool OSAKA_MapFile(MappedFile* file, const char* fileName)
+{
+	memset(file, 0, sizeof(MappedFile));
+	
+#if defined(_WIN32)
+	HANDLE handle = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	
+	if (handle == INVALID_HANDLE_VALUE) return false;
+	
+	LARGE_INTEGER size;
+	
+	if (GetFileSizeEx(handle, &size) && size.QuadPart > 0)
+	{
+		HANDLE mapping = CreateFileMappingA(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+		void* data = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+		
+		if (data)
+		{
+			file->data = data;
+			file->size = (size_t)size.QuadPart;
+			file->mapped = true;
+			file->fileHandle = handle;
+			file->mappingHandle = mapping;
+			
+			return true;
+		}
+		
+		if (mapping) CloseHandle(mapping);
+	}
+	
+	CloseHandle(handle);
+#elif defined(OSAKA_FILES_MMAP)
+	int descriptor = open(fileName, O_RDONLY);
+	
+	if (descriptor < 0) return false;
+	
+	struct stat status;
+	
+	if (!fstat(descriptor, &status) && status.st_size > 0)
+	{
+		void* data = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+		
+		if (data != MAP_FAILED)
+		{
+			close(descriptor);	// the mapping keeps its own reference
+			
+			file->data = data;
+			file->size = status.st_size;
+			file->mapped = true;
+			
+			return true;
+		}
+	}
+	
+	close(descriptor);
+#endif
+	
+	return readFile(file, fileName);
+}
+
+void OSAKA_UnmapFile(MappedFile* file)
+{
+	if (!file->data) return;
+	
+	if (file->mapped)
+	{
+#if defined(_WIN32)
+		UnmapViewOfFile(file->data);
+		CloseHandle(file->mappingHandle);
+		CloseHandle(file->fileHandle);
+#elif defined(OSAKA_FILES_MMAP)
+		munmap((void*)file->data, file->size);
+#endif
+	}
+	else
+	{
+		free((void*)file->data);
+	}
+	
+	memset(file, 0, sizeof(MappedFile));
+}
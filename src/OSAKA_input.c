@@ -0,0 +1,387 @@
+#include "OSAKA.h"
+#include <string.h>
+#include <limits.h>
+
+static int keys[INPUT_KEYS_LENGTH];		// key code of each bit, handed out the first time a key is asked about
+static int keysLength;
+static bool keysFull;
+
+static bool mouseButtonsPressed[MOUSE_BUTTONS_LENGTH];
+
+static InputTick tickInput;
+static uint32_t keysSampled;			// bits already read from raylib this tick
+
+static uint64_t (*worldHash)();
+
+// recording
+static bool recording;
+static char recordingFileName[PATH_CHARACTER_LENGTH];
+static ReplayRun* recordedRuns;
+static int recordedRunsLength, recordedRunsCapacity;
+static uint64_t* recordedHashes;
+static long long recordedTicks, recordedHashesCapacity;
+
+// replay
+static bool replaying;
+static MappedFile replayFile;
+static const ReplayRun* replayRuns;
+static const unsigned char* replayHashes;	// unaligned after the runs, read with memcpy
+static long long replayTicksLength;
+static long long replayTick;
+static int replayRun;
+static uint32_t replayRunTick;
+static long long replayDivergences;
+static long long replayFirstDivergence;
+
+static int keyBit(int key)
+{
+	for (int i = 0; i < keysLength; i++)
+	{
+		if (keys[i] == key) return i;
+	}
+	
+	if (keysLength == INPUT_KEYS_LENGTH)
+	{
+		if (!keysFull) TraceLog(LOG_WARNING, "too many keys to record, extra keys are read live and not recorded (key : %i) (length : %i)", key, INPUT_KEYS_LENGTH);
+		keysFull = true;
+		return -1;
+	}
+	
+	keys[keysLength] = key;
+	
+	return keysLength++;
+}
+
+void OSAKA_PollInput()
+{
+	for (int i = 0; i < MOUSE_BUTTONS_LENGTH; i++)
+	{
+		if (IsMouseButtonPressed(i)) mouseButtonsPressed[i] = true;
+	}
+}
+
+void OSAKA_BeginTickInput()
+{
+	keysSampled = 0;
+	
+	if (replaying)
+	{
+		while (replayRunTick >= replayRuns[replayRun].length)
+		{
+			replayRun++;
+			replayRunTick = 0;
+		}
+		
+		tickInput = replayRuns[replayRun].input;
+		replayRunTick++;
+		
+		return;
+	}
+	
+	tickInput = (InputTick){0};
+	
+	for (int i = 0; i < MOUSE_BUTTONS_LENGTH; i++)
+	{
+		if (mouseButtonsPressed[i]) tickInput.mouseButtons |= 1 << i;
+	}
+}
+
+static bool recordTick(uint64_t hash)
+{
+	if (recordedRunsLength && !memcmp(&recordedRuns[recordedRunsLength - 1].input, &tickInput, sizeof(InputTick)) &&
+		recordedRuns[recordedRunsLength - 1].length < UINT32_MAX)
+	{
+		recordedRuns[recordedRunsLength - 1].length++;
+	}
+	else
+	{
+		if (recordedRunsLength == recordedRunsCapacity)
+		{
+			int capacity = recordedRunsCapacity ? recordedRunsCapacity * 2 : 256;
+			ReplayRun* grown = realloc(recordedRuns, capacity * sizeof(ReplayRun));
+			
+			if (!grown) return false;
+			
+			recordedRuns = grown;
+			recordedRunsCapacity = capacity;
+		}
+		
+		recordedRuns[recordedRunsLength++] = (ReplayRun){ tickInput, 1 };
+	}
+	
+	if (recordedTicks == recordedHashesCapacity)
+	{
+		long long capacity = recordedHashesCapacity ? recordedHashesCapacity * 2 : 4096;
+		uint64_t* grown = realloc(recordedHashes, capacity * sizeof(uint64_t));
+		
+		if (!grown) return false;
+		
+		recordedHashes = grown;
+		recordedHashesCapacity = capacity;
+	}
+	
+	recordedHashes[recordedTicks++] = hash;
+	
+	return true;
+}
+
+void OSAKA_EndTickInput()
+{
+	for (int i = 0; i < MOUSE_BUTTONS_LENGTH; i++)
+	{
+		mouseButtonsPressed[i] = false;
+	}
+	
+	if (!recording && !replaying) return;
+	
+	uint64_t hash = worldHash ? worldHash() : 0;
+	
+	if (recording && !recordTick(hash))
+	{
+		TraceLog(LOG_ERROR, "could not record tick, out of memory, stopping recording (ticks : %lld)", recordedTicks);
+		OSAKA_StopRecording();
+	}
+	
+	if (!replaying) return;
+	
+	uint64_t expected;
+	memcpy(&expected, replayHashes + replayTick * sizeof(uint64_t), sizeof(uint64_t));
+	
+	if (worldHash && hash != expected)
+	{
+		if (!replayDivergences)
+		{
+			replayFirstDivergence = replayTick;
+			TraceLog(LOG_WARNING, "replay diverged (tick : %lld) (expected hash : %016llx) (hash : %016llx)",
+				replayTick, (unsigned long long)expected, (unsigned long long)hash);
+		}
+		
+		replayDivergences++;
+	}
+	
+	if (++replayTick < replayTicksLength) return;
+	
+	OSAKA_StopReplay();
+	
+	// nothing left to feed a headless run, so it ends with the replay
+	if (OSAKA_IsHeadless()) running = false;
+}
+
+bool OSAKA_IsKeyDown(int key)
+{
+	int bit = keyBit(key);
+	
+	if (bit < 0) return !replaying && IsKeyDown(key);
+	
+	uint32_t mask = 1u << bit;
+	
+	// read once per tick so every check in a tick agrees with what gets recorded
+	if (!replaying && !(keysSampled & mask))
+	{
+		keysSampled |= mask;
+		if (IsKeyDown(key)) tickInput.keys |= mask;
+	}
+	
+	return tickInput.keys & mask;
+}
+
+bool OSAKA_IsMouseButtonPressed(int button)
+{
+	if (button < 0 || button >= MOUSE_BUTTONS_LENGTH) return false;
+	
+	return tickInput.mouseButtons & (1 << button);
+}
+
+void OSAKA_SetWorldHash(uint64_t (*hash)())
+{
+	worldHash = hash;
+}
+
+// recording -----------------------------------------------------------------------------------------------------------
+
+bool OSAKA_StartRecording(char fileName[PATH_CHARACTER_LENGTH])
+{
+	if (recording) OSAKA_StopRecording();
+	
+	if (replaying)
+	{
+		TraceLog(LOG_ERROR, "could not start recording, a replay is playing (file name : %s)", fileName);
+		return false;
+	}
+	
+	strncpy(recordingFileName, fileName, PATH_CHARACTER_LENGTH - 1);
+	recordingFileName[PATH_CHARACTER_LENGTH - 1] = '\0';
+	
+	recordedRunsLength = 0;
+	recordedTicks = 0;
+	recording = true;
+	
+	TraceLog(LOG_INFO, "started recording (file name : %s)", fileName);
+	
+	return true;
+}
+
+bool OSAKA_StopRecording()
+{
+	if (!recording) return false;
+	
+	recording = false;
+	
+	ReplayHeader header = { REPLAY_MAGIC, REPLAY_VERSION, OSAKA_GetTickRate(), recordedRunsLength, recordedTicks, { 0 } };
+	
+	for (int i = 0; i < keysLength; i++)
+	{
+		header.keys[i] = keys[i];
+	}
+	
+	size_t runsSize = (size_t)recordedRunsLength * sizeof(ReplayRun);
+	size_t hashesSize = (size_t)recordedTicks * sizeof(uint64_t);
+	size_t size = sizeof(ReplayHeader) + runsSize + hashesSize;
+	unsigned char* data = malloc(size);
+	
+	bool saved = false;
+	
+	if (data && size <= INT_MAX)
+	{
+		memcpy(data, &header, sizeof(ReplayHeader));
+		if (runsSize) memcpy(data + sizeof(ReplayHeader), recordedRuns, runsSize);
+		if (hashesSize) memcpy(data + sizeof(ReplayHeader) + runsSize, recordedHashes, hashesSize);
+		
+		saved = SaveFileData(recordingFileName, data, (int)size);
+	}
+	
+	free(data);
+	free(recordedRuns);
+	free(recordedHashes);
+	
+	recordedRuns = NULL;
+	recordedHashes = NULL;
+	recordedRunsLength = recordedRunsCapacity = 0;
+	recordedHashesCapacity = 0;
+	
+	if (!saved)
+	{
+		TraceLog(LOG_ERROR, "could not save recording (file name : %s) (ticks : %lld)", recordingFileName, recordedTicks);
+		return false;
+	}
+	
+	TraceLog(LOG_INFO, "successfully saved recording (file name : %s) (ticks : %lld) (runs : %i) (size : %zu)",
+		recordingFileName, recordedTicks, header.runsLength, size);
+	
+	return true;
+}
+
+bool OSAKA_IsRecording()
+{
+	return recording;
+}
+
+// replay --------------------------------------------------------------------------------------------------------------
+
+bool OSAKA_StartReplay(char fileName[PATH_CHARACTER_LENGTH])
+{
+	if (replaying) OSAKA_StopReplay();
+	
+	if (recording)
+	{
+		TraceLog(LOG_ERROR, "could not start replay, recording (file name : %s)", fileName);
+		return false;
+	}
+	
+	if (!OSAKA_MapFile(&replayFile, fileName))
+	{
+		TraceLog(LOG_ERROR, "could not open replay, failed to read file (file name : %s)", fileName);
+		return false;
+	}
+	
+	const unsigned char* data = replayFile.data;
+	const ReplayHeader* header = (const ReplayHeader*)data;
+	
+	bool valid = replayFile.size >= sizeof(ReplayHeader) && !memcmp(header->magic, REPLAY_MAGIC, 4) && header->version == REPLAY_VERSION;
+	
+	if (valid)
+	{
+		size_t runsSize = (size_t)header->runsLength * sizeof(ReplayRun);
+		long long ticks = 0;
+		
+		valid = runsSize / sizeof(ReplayRun) == header->runsLength && header->ticksLength <= (replayFile.size - sizeof(ReplayHeader)) / sizeof(uint64_t) &&
+			replayFile.size - sizeof(ReplayHeader) - header->ticksLength * sizeof(uint64_t) == runsSize;
+		
+		replayRuns = (const ReplayRun*)(data + sizeof(ReplayHeader));
+		
+		for (uint32_t i = 0; valid && i < header->runsLength; i++)
+		{
+			ticks += replayRuns[i].length;
+		}
+		
+		// every tick needs a run to come from
+		valid = valid && ticks == (long long)header->ticksLength;
+	}
+	
+	if (!valid)
+	{
+		TraceLog(LOG_ERROR, "could not open replay, not a replay or truncated (file name : %s) (size : %zu)", fileName, replayFile.size);
+		OSAKA_UnmapFile(&replayFile);
+		return false;
+	}
+	
+	// bits mean what they meant when it was recorded
+	keysLength = 0;
+	keysFull = false;
+	
+	for (int i = 0; i < INPUT_KEYS_LENGTH && header->keys[i]; i++)
+	{
+		keys[keysLength++] = header->keys[i];
+	}
+	
+	if ((int)header->tickRate != OSAKA_GetTickRate()) OSAKA_SetTickRate(header->tickRate);
+	
+	replayHashes = data + sizeof(ReplayHeader) + (size_t)header->runsLength * sizeof(ReplayRun);
+	replayTicksLength = header->ticksLength;
+	replayTick = 0;
+	replayRun = 0;
+	replayRunTick = 0;
+	replayDivergences = 0;
+	replayFirstDivergence = -1;
+	replaying = replayTicksLength > 0;
+	
+	TraceLog(LOG_INFO, "started replay (file name : %s) (ticks : %lld) (runs : %u) (mapped : %s)",
+		fileName, replayTicksLength, header->runsLength, replayFile.mapped ? "yes" : "no");
+	
+	if (!replaying) OSAKA_UnmapFile(&replayFile);
+	
+	return true;
+}
+
+void OSAKA_StopReplay()
+{
+	if (!replaying) return;
+	
+	replaying = false;
+	
+	TraceLog(replayDivergences ? LOG_WARNING : LOG_INFO, "finished replay (ticks : %lld) (of : %lld) (diverged ticks : %lld) (first divergence : %lld)",
+		replayTick, replayTicksLength, replayDivergences, replayFirstDivergence);
+	
+	OSAKA_UnmapFile(&replayFile);
+	
+	replayRuns = NULL;
+	replayHashes = NULL;
+}
+
+bool OSAKA_IsReplaying()
+{
+	return replaying;
+}
+
+long long OSAKA_GetReplayDivergences()
+{
+	return replayDivergences;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void OSAKA_QuitInput()
+{
+	OSAKA_StopRecording();
+	OSAKA_StopReplay();
+}
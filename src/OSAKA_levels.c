@@ -0,0 +1,227 @@
+#include "OSAKA.h"
+#include <string.h>
+#include <limits.h>
+
+static size_t align(size_t offset)
+{
+	return (offset + LEVEL_PACK_ALIGNMENT - 1) & ~(size_t)(LEVEL_PACK_ALIGNMENT - 1);
+}
+
+static bool inPack(size_t size, uint32_t offset, size_t length)
+{
+	return offset <= size && length <= size - offset;
+}
+
+static bool checkLevelPack(LevelPack* pack, const char* name)
+{
+	const unsigned char* data = pack->file.data;
+	size_t size = pack->file.size;
+	const LevelPackHeader* header = (const LevelPackHeader*)data;
+	
+	if (size < sizeof(LevelPackHeader) || memcmp(header->magic, LEVEL_PACK_MAGIC, 4))
+	{
+		TraceLog(LOG_ERROR, "could not open level pack, not a level pack (file name : %s)", name);
+		return false;
+	}
+	
+	if (header->version != LEVEL_PACK_VERSION)
+	{
+		TraceLog(LOG_ERROR, "could not open level pack, unsupported version (file name : %s) (version : %u) (supported : %i)", name, header->version, LEVEL_PACK_VERSION);
+		return false;
+	}
+	
+	if (header->size > size || !inPack(size, sizeof(LevelPackHeader), (size_t)header->levelsLength * sizeof(LevelPackEntry)))
+	{
+		TraceLog(LOG_ERROR, "could not open level pack, truncated (file name : %s) (size : %zu)", name, size);
+		return false;
+	}
+	
+	pack->entries = (const LevelPackEntry*)(data + sizeof(LevelPackHeader));
+	pack->levelsLength = header->levelsLength;
+	
+	for (int i = 0; i < pack->levelsLength; i++)
+	{
+		const LevelPackEntry* entry = &pack->entries[i];
+		
+		bool valid = inPack(size, entry->tilesOffset, (size_t)entry->gridWidth * entry->gridHeight) &&
+			!(entry->spawnsOffset % LEVEL_PACK_ALIGNMENT) &&
+			inPack(size, entry->spawnsOffset, (size_t)entry->spawnsLength * sizeof(LevelSpawn)) &&
+			(!entry->textOffset || (entry->textOffset < size && memchr(data + entry->textOffset, '\0', size - entry->textOffset)));
+		
+		if (!valid)
+		{
+			TraceLog(LOG_ERROR, "could not open level pack, level points outside the pack (file name : %s) (level : %i)", name, i);
+			return false;
+		}
+	}
+	
+	return true;
+}
+
+bool OSAKA_OpenLevelPack(LevelPack* pack, char fileName[PATH_CHARACTER_LENGTH])
+{
+	memset(pack, 0, sizeof(LevelPack));
+	
+	if (!OSAKA_MapFile(&pack->file, fileName))
+	{
+		TraceLog(LOG_WARNING, "could not open level pack, failed to read file (file name : %s)", fileName);
+		return false;
+	}
+	
+	if (!checkLevelPack(pack, fileName))
+	{
+		OSAKA_CloseLevelPack(pack);
+		return false;
+	}
+	
+	TraceLog(LOG_INFO, "successfully opened level pack (file name : %s) (levels : %i) (mapped : %s)", fileName, pack->levelsLength, pack->file.mapped ? "yes" : "no");
+	
+	return true;
+}
+
+bool OSAKA_OpenLevelPackFromMemory(LevelPack* pack, void* data, size_t size)
+{
+	memset(pack, 0, sizeof(LevelPack));
+	
+	if (!data) return false;
+	
+	pack->file = (MappedFile){ data, size, false };
+	
+	if (!checkLevelPack(pack, "memory"))
+	{
+		OSAKA_CloseLevelPack(pack);
+		return false;
+	}
+	
+	return true;
+}
+
+void OSAKA_CloseLevelPack(LevelPack* pack)
+{
+	OSAKA_UnmapFile(&pack->file);
+	
+	memset(pack, 0, sizeof(LevelPack));
+}
+
+bool OSAKA_GetLevel(LevelPack* pack, int index, Level* level)
+{
+	if (index < 0 || index >= pack->levelsLength)
+	{
+		TraceLog(LOG_ERROR, "could not get level, index out of bounds (index : %i) (levels length : %i)", index, pack->levelsLength);
+		return false;
+	}
+	
+	const unsigned char* data = pack->file.data;
+	const LevelPackEntry* entry = &pack->entries[index];
+	
+	*level = (Level){
+		entry->gridWidth, entry->gridHeight,
+		data + entry->tilesOffset,
+		(const LevelSpawn*)(data + entry->spawnsOffset), entry->spawnsLength,
+		entry->music, entry->sound,
+		entry->textOffset ? (const char*)(data + entry->textOffset) : NULL,
+		entry->textX, entry->textY, entry->textSize,
+		(Color){ entry->textColor[0], entry->textColor[1], entry->textColor[2], entry->textColor[3] }
+	};
+	
+	return true;
+}
+
+void* OSAKA_BuildLevelPack(const Level* levels, int levelsLength, size_t* size)
+{
+	// first pass lays everything out, second pass copies it in
+	size_t length = align(sizeof(LevelPackHeader) + (size_t)levelsLength * sizeof(LevelPackEntry));
+	
+	for (int i = 0; i < levelsLength; i++)
+	{
+		length = align(length + levels[i].spawnsLength * sizeof(LevelSpawn));
+		length = align(length + (size_t)levels[i].gridWidth * levels[i].gridHeight);
+		if (levels[i].text) length = align(length + strlen(levels[i].text) + 1);
+	}
+	
+	if (length > UINT32_MAX)
+	{
+		TraceLog(LOG_ERROR, "could not build level pack, too big (size : %zu)", length);
+		return NULL;
+	}
+	
+	unsigned char* data = calloc(1, length);
+	
+	if (!data)
+	{
+		TraceLog(LOG_ERROR, "could not build level pack, out of memory (size : %zu)", length);
+		return NULL;
+	}
+	
+	LevelPackHeader* header = (LevelPackHeader*)data;
+	LevelPackEntry* entries = (LevelPackEntry*)(data + sizeof(LevelPackHeader));
+	size_t offset = align(sizeof(LevelPackHeader) + (size_t)levelsLength * sizeof(LevelPackEntry));
+	
+	memcpy(header->magic, LEVEL_PACK_MAGIC, 4);
+	header->version = LEVEL_PACK_VERSION;
+	header->levelsLength = levelsLength;
+	header->size = length;
+	
+	for (int i = 0; i < levelsLength; i++)
+	{
+		const Level* level = &levels[i];
+		LevelPackEntry* entry = &entries[i];
+		size_t tilesLength = (size_t)level->gridWidth * level->gridHeight;
+		
+		entry->gridWidth = level->gridWidth;
+		entry->gridHeight = level->gridHeight;
+		entry->music = level->music;
+		entry->sound = level->sound;
+		entry->textX = level->textX;
+		entry->textY = level->textY;
+		entry->textSize = level->textSize;
+		entry->textColor[0] = level->textColor.r;
+		entry->textColor[1] = level->textColor.g;
+		entry->textColor[2] = level->textColor.b;
+		entry->textColor[3] = level->textColor.a;
+		
+		entry->spawnsOffset = offset;
+		entry->spawnsLength = level->spawnsLength;
+		if (level->spawnsLength) memcpy(data + offset, level->spawns, level->spawnsLength * sizeof(LevelSpawn));
+		offset = align(offset + level->spawnsLength * sizeof(LevelSpawn));
+		
+		entry->tilesOffset = offset;
+		if (tilesLength) memcpy(data + offset, level->tiles, tilesLength);
+		offset = align(offset + tilesLength);
+		
+		if (level->text)
+		{
+			size_t textLength = strlen(level->text) + 1;
+			
+			entry->textOffset = offset;
+			memcpy(data + offset, level->text, textLength);
+			offset = align(offset + textLength);
+		}
+	}
+	
+	*size = length;
+	
+	return data;
+}
+
+bool OSAKA_SaveLevelPack(char fileName[PATH_CHARACTER_LENGTH], const Level* levels, int levelsLength)
+{
+	size_t size;
+	void* data = OSAKA_BuildLevelPack(levels, levelsLength, &size);
+	
+	if (!data) return false;
+	
+	bool saved = size <= INT_MAX && SaveFileData(fileName, data, (int)size);
+	
+	free(data);
+	
+	if (!saved)
+	{
+		TraceLog(LOG_ERROR, "could not save level pack (file name : %s)", fileName);
+		return false;
+	}
+	
+	TraceLog(LOG_INFO, "successfully saved level pack (file name : %s) (levels : %i) (size : %zu)", fileName, levelsLength, size);
+	
+	return true;
+}
@@ -0,0 +1,309 @@
+#include "OSAKA.h"
+#include <string.h>
+#include <stdio.h>
+
+static const char* textureExtensions = ".png;.bmp;.tga;.jpg;.gif;.qoi;.psd;.hdr;.pic;.pnm";
+static const char* soundExtensions = ".wav";
+static const char* musicExtensions = ".mp3;.ogg;.flac;.qoa;.xm;.mod";
+static const char* fontExtensions = ".ttf;.otf";
+
+// names are stored without the resources directory so packs do not care where they were built
+static const char* assetName(const char* fileName, const char* directory)
+{
+	size_t length = strlen(directory);
+	
+	if (!strncmp(fileName, directory, length)) fileName += length;
+	while (*fileName == '/' || *fileName == '\\') fileName++;
+	
+	return fileName;
+}
+
+static void copyName(char name[ASSET_PACK_NAME_LENGTH], const char* fileName)
+{
+	int i = 0;
+	
+	for (; fileName[i] && i < ASSET_PACK_NAME_LENGTH - 1; i++)
+	{
+		name[i] = fileName[i] == '\\' ? '/' : fileName[i];
+	}
+	
+	name[i] = '\0';
+}
+
+static int compareEntries(const void* a, const void* b)
+{
+	return strcmp(((const AssetPackEntry*)a)->name, ((const AssetPackEntry*)b)->name);
+}
+
+static bool inPack(size_t size, uint64_t offset, uint64_t length)
+{
+	return offset <= size && length <= size - offset;
+}
+
+// the loaders hand these fields straight to raylib, so anything they would read past the asset is rejected here
+static bool checkAssetEntry(const AssetPackEntry* entry, size_t size)
+{
+	if (!inPack(size, entry->offset, entry->size)) return false;
+	if (!memchr(entry->name, '\0', ASSET_PACK_NAME_LENGTH) || !memchr(entry->extension, '\0', sizeof(entry->extension))) return false;
+	
+	switch (entry->type)
+	{
+		case ASSET_TEXTURE:
+			// the pack only keeps the base level, see packAsset
+			return entry->width > 0 && entry->height > 0 && entry->mipmaps == 1 &&
+				entry->format >= PIXELFORMAT_UNCOMPRESSED_GRAYSCALE && entry->format <= PIXELFORMAT_COMPRESSED_ASTC_8x8_RGBA &&
+				(uint64_t)GetPixelDataSize(entry->width, entry->height, entry->format) <= entry->size;
+		
+		case ASSET_SOUND:
+			return (entry->sampleSize == 8 || entry->sampleSize == 16 || entry->sampleSize == 32) && entry->channels > 0 &&
+				entry->frameCount <= entry->size / ((uint64_t)entry->channels * (entry->sampleSize / 8));
+		
+		case ASSET_MUSIC:
+		case ASSET_FONT:
+			return entry->size <= INT32_MAX;
+		
+		default:
+			return false;
+	}
+}
+
+static bool checkAssetPack(AssetPack* pack, const char* name)
+{
+	const unsigned char* data = pack->file.data;
+	size_t size = pack->file.size;
+	const AssetPackHeader* header = (const AssetPackHeader*)data;
+	
+	if (size < sizeof(AssetPackHeader) || memcmp(header->magic, ASSET_PACK_MAGIC, 4))
+	{
+		TraceLog(LOG_ERROR, "could not open asset pack, not an asset pack (file name : %s)", name);
+		return false;
+	}
+	
+	if (header->version != ASSET_PACK_VERSION)
+	{
+		TraceLog(LOG_ERROR, "could not open asset pack, unsupported version (file name : %s) (version : %u) (supported : %i)", name, header->version, ASSET_PACK_VERSION);
+		return false;
+	}
+	
+	if (header->size > size || !inPack(size, sizeof(AssetPackHeader), (uint64_t)header->entriesLength * sizeof(AssetPackEntry)))
+	{
+		TraceLog(LOG_ERROR, "could not open asset pack, truncated (file name : %s) (size : %zu)", name, size);
+		return false;
+	}
+	
+	const AssetPackEntry* entries = (const AssetPackEntry*)(data + sizeof(AssetPackHeader));
+	
+	for (uint32_t i = 0; i < header->entriesLength; i++)
+	{
+		if (!checkAssetEntry(&entries[i], size))
+		{
+			TraceLog(LOG_ERROR, "could not open asset pack, asset is broken or points outside the pack (file name : %s) (asset : %u)", name, i);
+			return false;
+		}
+	}
+	
+	pack->entries = entries;
+	pack->entriesLength = header->entriesLength;
+	
+	return true;
+}
+
+bool OSAKA_OpenAssetPack(AssetPack* pack, char fileName[PATH_CHARACTER_LENGTH])
+{
+	memset(pack, 0, sizeof(AssetPack));
+	
+	if (!OSAKA_MapFile(&pack->file, fileName))
+	{
+		TraceLog(LOG_INFO, "no asset pack, loading files one by one (file name : %s)", fileName);
+		return false;
+	}
+	
+	if (!checkAssetPack(pack, fileName))
+	{
+		OSAKA_CloseAssetPack(pack);
+		return false;
+	}
+	
+	TraceLog(LOG_INFO, "successfully opened asset pack (file name : %s) (assets : %i) (mapped : %s)", fileName, pack->entriesLength, pack->file.mapped ? "yes" : "no");
+	
+	return true;
+}
+
+void OSAKA_CloseAssetPack(AssetPack* pack)
+{
+	OSAKA_UnmapFile(&pack->file);
+	
+	memset(pack, 0, sizeof(AssetPack));
+}
+
+const AssetPackEntry* OSAKA_FindAsset(AssetPack* pack, const char* fileName)
+{
+	if (!pack->entriesLength) return NULL;
+	
+	AssetPackEntry key;
+	copyName(key.name, assetName(fileName, RESOURCES_PATH));
+	
+	return bsearch(&key, pack->entries, pack->entriesLength, sizeof(AssetPackEntry), compareEntries);
+}
+
+const void* OSAKA_GetAssetData(AssetPack* pack, const AssetPackEntry* entry)
+{
+	return (const unsigned char*)pack->file.data + entry->offset;
+}
+
+// builder -------------------------------------------------------------------------------------------------------------
+
+static bool writeAsset(FILE* stream, uint64_t* offset, AssetPackEntry* entry, const void* data, uint64_t size)
+{
+	static const char padding[ASSET_PACK_ALIGNMENT];
+	uint64_t aligned = (*offset + ASSET_PACK_ALIGNMENT - 1) / ASSET_PACK_ALIGNMENT * ASSET_PACK_ALIGNMENT;
+	
+	if (fwrite(padding, 1, aligned - *offset, stream) != aligned - *offset) return false;
+	if (size && fwrite(data, 1, size, stream) != size) return false;
+	
+	entry->offset = aligned;
+	entry->size = size;
+	*offset = aligned + size;
+	
+	return true;
+}
+
+static bool packAsset(FILE* stream, uint64_t* offset, AssetPackEntry* entry, const char* path)
+{
+	if (IsFileExtension(path, textureExtensions))
+	{
+		Image image = LoadImage(path);
+		
+		if (!image.data) return false;
+		
+		entry->type = ASSET_TEXTURE;
+		entry->width = image.width;
+		entry->height = image.height;
+		entry->mipmaps = image.mipmaps;
+		entry->format = image.format;
+		
+		bool written = writeAsset(stream, offset, entry, image.data, GetPixelDataSize(image.width, image.height, image.format));
+		UnloadImage(image);
+		
+		return written;
+	}
+	
+	if (IsFileExtension(path, soundExtensions))
+	{
+		Wave wave = LoadWave(path);
+		
+		if (!wave.data) return false;
+		
+		entry->type = ASSET_SOUND;
+		entry->frameCount = wave.frameCount;
+		entry->sampleRate = wave.sampleRate;
+		entry->sampleSize = wave.sampleSize;
+		entry->channels = wave.channels;
+		
+		bool written = writeAsset(stream, offset, entry, wave.data, (uint64_t)wave.frameCount * wave.channels * (wave.sampleSize / 8));
+		UnloadWave(wave);
+		
+		return written;
+	}
+	
+	bool music = IsFileExtension(path, musicExtensions);
+	
+	if (music || IsFileExtension(path, fontExtensions))
+	{
+		int size = 0;
+		unsigned char* data = LoadFileData(path, &size);
+		
+		if (!data) return false;
+		
+		entry->type = music ? ASSET_MUSIC : ASSET_FONT;
+		
+		bool written = writeAsset(stream, offset, entry, data, size);
+		UnloadFileData(data);
+		
+		return written;
+	}
+	
+	return false;
+}
+
+bool OSAKA_SaveAssetPack(char fileName[PATH_CHARACTER_LENGTH], char directory[PATH_CHARACTER_LENGTH])
+{
+	FilePathList files = LoadDirectoryFilesEx(directory, NULL, true);
+	AssetPackEntry* entries = calloc(files.count ? files.count : 1, sizeof(AssetPackEntry));
+	FILE* stream = fopen(fileName, "wb");
+	
+	if (!entries || !stream)
+	{
+		TraceLog(LOG_ERROR, "could not save asset pack, failed to open file (file name : %s)", fileName);
+		
+		if (stream) fclose(stream);
+		free(entries);
+		UnloadDirectoryFiles(files);
+		
+		return false;
+	}
+	
+	// the header and entry table are written last, once every offset is known
+	uint64_t offset = sizeof(AssetPackHeader) + (uint64_t)files.count * sizeof(AssetPackEntry);
+	int entriesLength = 0;
+	bool failed = fseek(stream, (long)offset, SEEK_SET) != 0;
+	
+	for (unsigned int i = 0; i < files.count && !failed; i++)
+	{
+		const char* path = files.paths[i];
+		const char* name = assetName(path, directory);
+		AssetPackEntry* entry = &entries[entriesLength];
+		
+		if (strlen(name) >= ASSET_PACK_NAME_LENGTH)
+		{
+			TraceLog(LOG_WARNING, "skipped asset, name too long (file name : %s)", path);
+			continue;
+		}
+		
+		memset(entry, 0, sizeof(AssetPackEntry));
+		copyName(entry->name, name);
+		strncpy(entry->extension, GetFileExtension(path) ? GetFileExtension(path) : "", sizeof(entry->extension) - 1);
+		
+		long start = ftell(stream);
+		
+		if (!packAsset(stream, &offset, entry, path))
+		{
+			// not an asset type or it would not decode, wind back over anything half written
+			fseek(stream, start, SEEK_SET);
+			offset = start;
+			
+			TraceLog(LOG_DEBUG, "skipped file, not a packable asset (file name : %s)", path);
+			continue;
+		}
+		
+		TraceLog(LOG_INFO, "packed asset (name : %s) (size : %llu)", entry->name, (unsigned long long)entry->size);
+		entriesLength++;
+	}
+	
+	qsort(entries, entriesLength, sizeof(AssetPackEntry), compareEntries);
+	
+	AssetPackHeader header = {0};
+	memcpy(header.magic, ASSET_PACK_MAGIC, 4);
+	header.version = ASSET_PACK_VERSION;
+	header.entriesLength = entriesLength;
+	header.size = offset;
+	
+	// the table was sized for every file, unused entries stay zeroed and are never looked at
+	failed = failed || fseek(stream, 0, SEEK_SET) ||
+		fwrite(&header, sizeof(header), 1, stream) != 1 ||
+		(entriesLength && fwrite(entries, sizeof(AssetPackEntry), entriesLength, stream) != (size_t)entriesLength);
+	
+	failed = fclose(stream) || failed;
+	free(entries);
+	UnloadDirectoryFiles(files);
+	
+	if (failed)
+	{
+		TraceLog(LOG_ERROR, "could not save asset pack, failed to write (file name : %s)", fileName);
+		return false;
+	}
+	
+	TraceLog(LOG_INFO, "successfully saved asset pack (file name : %s) (assets : %i) (size : %llu)", fileName, entriesLength, (unsigned long long)offset);
+	
+	return true;
+}
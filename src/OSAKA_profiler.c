@@ -0,0 +1,353 @@
+#include "OSAKA.h"
+#include <stdio.h>
+#include <string.h>
+
+// the only shared state is each thread's head and the thread list, so zones never take a lock
+#if defined(_MSC_VER)
+	#include <intrin.h>
+	#define THREAD_LOCAL __declspec(thread)
+	#define ATOMIC_LOAD(value) (value)				// msvc volatile accesses already acquire and release
+	#define ATOMIC_STORE(value, x) ((value) = (x))
+	#define ATOMIC_INCREMENT(value) (_InterlockedIncrement(&(value)) - 1)
+#else
+	#define THREAD_LOCAL __thread
+	#define ATOMIC_LOAD(value) __atomic_load_n(&(value), __ATOMIC_ACQUIRE)
+	#define ATOMIC_STORE(value, x) __atomic_store_n(&(value), (x), __ATOMIC_RELEASE)
+	#define ATOMIC_INCREMENT(value) __atomic_fetch_add(&(value), 1, __ATOMIC_ACQ_REL)
+#endif
+
+#define RECORDS_MASK (PROFILER_RECORDS_LENGTH - 1)
+
+typedef struct ProfileThread
+{
+	ProfileRecord records[PROFILER_RECORDS_LENGTH];
+	volatile uint32_t head;		// records ever written, wraps, only the owning thread writes it
+	int id;
+} ProfileThread;
+
+typedef struct ProfileZone
+{
+	const char* name;
+	int depth;
+	uint64_t first;		// start of the first call ever seen, orders the overlay
+	uint64_t frameTime;
+	int frameCalls;
+	int calls;
+	uint64_t history[PROFILER_HISTORY_LENGTH];
+} ProfileZone;
+
+static ProfileThread* volatile threads[PROFILER_THREADS_LENGTH];
+static volatile long threadsLength;
+
+static THREAD_LOCAL ProfileThread* thread;
+static THREAD_LOCAL bool threadFailed;
+static THREAD_LOCAL const char* stackNames[PROFILER_DEPTH];
+static THREAD_LOCAL uint64_t stackStarts[PROFILER_DEPTH];
+static THREAD_LOCAL int depth;
+
+// overlay, only touched by the thread calling OSAKA_ProfileFrame
+static ProfileZone zones[PROFILER_ZONES_LENGTH];
+static int zonesLength;
+static int historyIndex;
+static int historyLength;
+static uint32_t frameHead;
+static bool overlayVisible;
+
+static ProfileThread* registerThread()
+{
+	if (threadFailed) return NULL;
+	
+	long id = ATOMIC_INCREMENT(threadsLength);
+	
+	if (id >= PROFILER_THREADS_LENGTH)
+	{
+		threadFailed = true;
+		TraceLog(LOG_WARNING, "too many threads to profile, zones on this thread are dropped (length : %i)", PROFILER_THREADS_LENGTH);
+		return NULL;
+	}
+	
+	ProfileThread* created = calloc(1, sizeof(ProfileThread));
+	
+	if (!created)
+	{
+		threadFailed = true;
+		TraceLog(LOG_ERROR, "could not allocate profiler records (thread : %li)", id);
+		return NULL;
+	}
+	
+	created->id = id;
+	ATOMIC_STORE(threads[id], created);
+	
+	thread = created;
+	return created;
+}
+
+void OSAKA_ProfileBegin(const char* name)
+{
+	int index = depth++;
+	
+	if (index >= PROFILER_DEPTH) return;
+	
+	stackNames[index] = name;
+	stackStarts[index] = OSAKA_GetTimeNanoseconds();
+}
+
+void OSAKA_ProfileEnd()
+{
+	uint64_t end = OSAKA_GetTimeNanoseconds();
+	
+	if (depth <= 0)
+	{
+		TraceLog(LOG_WARNING, "profile zone ended without beginning");
+		return;
+	}
+	
+	int index = --depth;
+	
+	if (index >= PROFILER_DEPTH) return;
+	
+	ProfileThread* owner = thread ? thread : registerThread();
+	
+	if (!owner) return;
+	
+	uint32_t head = owner->head;
+	
+	owner->records[head & RECORDS_MASK] = (ProfileRecord){ stackNames[index], stackStarts[index], end, index };
+	
+	// published after the record so anything that sees the new head sees the whole record
+	ATOMIC_STORE(owner->head, head + 1);
+}
+
+// overlay -------------------------------------------------------------------------------------------------------------
+
+static ProfileZone* findZone(const ProfileRecord* record)
+{
+	for (int i = 0; i < zonesLength; i++)
+	{
+		// literals with the same text are usually merged, the compare catches the ones that are not
+		if (zones[i].name == record->name || !strcmp(zones[i].name, record->name)) return &zones[i];
+	}
+	
+	if (zonesLength >= PROFILER_ZONES_LENGTH) return NULL;
+	
+	ProfileZone* zone = &zones[zonesLength++];
+	
+	*zone = (ProfileZone){0};
+	zone->name = record->name;
+	zone->depth = record->depth;
+	zone->first = record->start;
+	
+	return zone;
+}
+
+static int compareZones(const void* a, const void* b)
+{
+	const ProfileZone* zoneA = *(const ProfileZone**)a;
+	const ProfileZone* zoneB = *(const ProfileZone**)b;
+	
+	return (zoneA->first > zoneB->first) - (zoneA->first < zoneB->first);
+}
+
+void OSAKA_ProfileFrame()
+{
+	ProfileThread* owner = thread ? thread : registerThread();
+	
+	if (!owner) return;
+	
+	uint32_t head = owner->head;
+	
+	// nobody is looking, skip the roll up and just keep up with the records
+	if (!overlayVisible)
+	{
+		frameHead = head;
+		return;
+	}
+	
+	// a frame that wrote more than the ring holds only counts what is left of it
+	if (head - frameHead > PROFILER_RECORDS_LENGTH) frameHead = head - PROFILER_RECORDS_LENGTH;
+	
+	for (; frameHead != head; frameHead++)
+	{
+		const ProfileRecord* record = &owner->records[frameHead & RECORDS_MASK];
+		ProfileZone* zone = findZone(record);
+		
+		if (!zone) continue;
+		
+		zone->frameTime += record->end - record->start;
+		zone->frameCalls++;
+	}
+	
+	for (int i = 0; i < zonesLength; i++)
+	{
+		zones[i].history[historyIndex] = zones[i].frameTime;
+		zones[i].calls = zones[i].frameCalls;
+		zones[i].frameTime = 0;
+		zones[i].frameCalls = 0;
+	}
+	
+	historyIndex = (historyIndex + 1) % PROFILER_HISTORY_LENGTH;
+	if (historyLength < PROFILER_HISTORY_LENGTH) historyLength++;
+}
+
+void OSAKA_SetProfilerOverlay(bool visible)
+{
+	if (visible && !overlayVisible)
+	{
+		// stale history would average in whatever was going on when it was last open
+		zonesLength = 0;
+		historyIndex = 0;
+		historyLength = 0;
+		frameHead = thread ? thread->head : 0;
+	}
+	
+	overlayVisible = visible;
+}
+
+bool OSAKA_IsProfilerOverlayVisible()
+{
+	return overlayVisible;
+}
+
+void OSAKA_DrawProfilerOverlay(int x, int y)
+{
+	if (!overlayVisible) return;
+	
+	ProfileZone* sorted[PROFILER_ZONES_LENGTH];
+	
+	for (int i = 0; i < zonesLength; i++)
+	{
+		sorted[i] = &zones[i];
+	}
+	
+	qsort(sorted, zonesLength, sizeof(ProfileZone*), compareZones);
+	
+	int lineHeight = 12;
+	
+	DrawRectangle(x, y, 340, (zonesLength + 1) * lineHeight + 8, Fade(BLACK, 0.75f));
+	DrawText(TextFormat("zone (frames : %i)", historyLength), x + 4, y + 4, 10, LIGHTGRAY);
+	DrawText("avg ms   max ms   calls", x + 200, y + 4, 10, LIGHTGRAY);
+	
+	for (int i = 0; i < zonesLength; i++)
+	{
+		ProfileZone* zone = sorted[i];
+		uint64_t total = 0;
+		uint64_t max = 0;
+		
+		for (int j = 0; j < historyLength; j++)
+		{
+			total += zone->history[j];
+			if (zone->history[j] > max) max = zone->history[j];
+		}
+		
+		double average = historyLength ? (double)total / historyLength : 0;
+		int lineY = y + 4 + (i + 1) * lineHeight;
+		
+		DrawText(zone->name, x + 4 + zone->depth * 8, lineY, 10, WHITE);
+		DrawText(TextFormat("%6.3f   %6.3f   %i", average / 1000000.0, max / 1000000.0, zone->calls), x + 200, lineY, 10, WHITE);
+	}
+}
+
+// export --------------------------------------------------------------------------------------------------------------
+
+static void writeName(FILE* file, const char* name)
+{
+	for (; *name; name++)
+	{
+		if (*name == '"' || *name == '\\') fputc('\\', file);
+		if ((unsigned char)*name >= ' ') fputc(*name, file);
+	}
+}
+
+bool OSAKA_SaveProfile(char fileName[PATH_CHARACTER_LENGTH])
+{
+	FILE* file = fopen(fileName, "wb");
+	
+	if (!file)
+	{
+		TraceLog(LOG_ERROR, "could not open profile for writing (file name : %s)", fileName);
+		return false;
+	}
+	
+	long length = ATOMIC_LOAD(threadsLength);
+	if (length > PROFILER_THREADS_LENGTH) length = PROFILER_THREADS_LENGTH;
+	
+	// trace timestamps only need to be consistent, starting them at the oldest record keeps them readable
+	uint64_t origin = UINT64_MAX;
+	
+	for (long i = 0; i < length; i++)
+	{
+		ProfileThread* owner = ATOMIC_LOAD(threads[i]);
+		if (!owner) continue;
+		
+		uint32_t head = ATOMIC_LOAD(owner->head);
+		uint32_t tail = head > PROFILER_RECORDS_LENGTH ? head - PROFILER_RECORDS_LENGTH : 0;
+		
+		for (uint32_t j = tail; j != head; j++)
+		{
+			if (owner->records[j & RECORDS_MASK].start < origin) origin = owner->records[j & RECORDS_MASK].start;
+		}
+	}
+	
+	fputs("{\"traceEvents\":[\n", file);
+	
+	int written = 0;
+	
+	for (long i = 0; i < length; i++)
+	{
+		ProfileThread* owner = ATOMIC_LOAD(threads[i]);
+		if (!owner) continue;
+		
+		// ids go by whichever thread finished a zone first, the trace viewer shows which is which from the zone names
+		fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%i,\"args\":{\"name\":\"thread %i\"}}",
+			written++ ? ",\n" : "", owner->id, owner->id);
+		
+		// other threads keep recording while this runs, a slow write can see their oldest records overwritten
+		uint32_t head = ATOMIC_LOAD(owner->head);
+		uint32_t tail = head > PROFILER_RECORDS_LENGTH ? head - PROFILER_RECORDS_LENGTH : 0;
+		
+		for (uint32_t j = tail; j != head; j++)
+		{
+			ProfileRecord record = owner->records[j & RECORDS_MASK];
+			
+			fputs(",\n{\"name\":\"", file);
+			writeName(file, record.name);
+			fprintf(file, "\",\"ph\":\"X\",\"pid\":1,\"tid\":%i,\"ts\":%.3f,\"dur\":%.3f}",
+				owner->id, (record.start - origin) / 1000.0, (record.end - record.start) / 1000.0);
+			
+			written++;
+		}
+	}
+	
+	fputs("\n]}\n", file);
+	
+	bool failed = ferror(file);
+	fclose(file);
+	
+	if (failed)
+	{
+		TraceLog(LOG_ERROR, "could not write profile (file name : %s)", fileName);
+		return false;
+	}
+	
+	TraceLog(LOG_INFO, "successfully saved profile (file name : %s) (events : %i)", fileName, written);
+	return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void OSAKA_QuitProfiler()
+{
+	// every other thread has to be joined by now, their records go with them
+	long length = ATOMIC_LOAD(threadsLength);
+	if (length > PROFILER_THREADS_LENGTH) length = PROFILER_THREADS_LENGTH;
+	
+	for (long i = 0; i < length; i++)
+	{
+		free(threads[i]);
+		threads[i] = NULL;
+	}
+	
+	threadsLength = 0;
+	thread = NULL;
+	zonesLength = 0;
+}
@@ -1,259 +1,1022 @@
-#include "OSAKA.h"
-
-Texture2D textures[TEXTURES_LENGTH];
-Sound sounds[SOUNDS_LENGTH];
-Music musicTracks[MUSIC_LENGTH];
-Font fonts[FONTS_LENGTH];
-
-// textures ------------------------------------------------------------------------------------------------------------
-
-int OSAKA_LoadTexture(char fileName[PATH_CHARACTER_LENGTH], int index)
-{
-	if (index < 0 || index >= TEXTURES_LENGTH)
-    {
-        TraceLog(LOG_ERROR, "could not load texture, index out of bounds (file name : %s) (index : %i) (textures length : %i)", fileName, index, TEXTURES_LENGTH);
-        return 0;
-    }
-	
-	if (textures[index].id)
-    {
-        TraceLog(LOG_ERROR, "could not load texture, slot is not empty (file name : %s) (index : %i)", fileName, index);
-        return 0;
-    }
-	
-	Texture2D texture = LoadTexture(fileName);
-	
-	if (!texture.id)
-    {
-		TraceLog(LOG_ERROR, "failed to load texture, invalid file name (file name : %s) (index : %i)", fileName, index);
-		return 0;
-    }
-	
-	textures[index] = texture;
-	TraceLog(LOG_INFO, "successfully loaded texture (file name : %s) (index : %i)", fileName, index);
-	
-	return index;
-}
-
-void OSAKA_UnloadTexture(int index)
-{
-	if (index < 0 || index >= TEXTURES_LENGTH)
-    {
-        TraceLog(LOG_ERROR, "could not unload texture, index out of bounds (index : %i) (textures length : %i)", index, TEXTURES_LENGTH);
-        return;
-    }
-	
-	if (!textures[index].id)
-    {
-        TraceLog(LOG_ERROR, "could not unload texture, slot is empty (index : %i)", index);
-        return;
-    }
-	
-	UnloadTexture(textures[index]);
-    textures[index] = (Texture2D){0};	// make index empty by reinitialising
-	
-	TraceLog(LOG_INFO, "successfully unloaded texture (index : %i)", index);
-}
-
-// sounds --------------------------------------------------------------------------------------------------------------
-
-int OSAKA_LoadSound(char fileName[PATH_CHARACTER_LENGTH], int index)
-{
-	if (index < 0 || index >= SOUNDS_LENGTH)
-    {
-        TraceLog(LOG_ERROR, "could not load sound, index out of bounds (index : %i) (sounds length : %i)", index, SOUNDS_LENGTH);
-        return 0;
-    }
-	
-	if (sounds[index].frameCount)
-    {
-        TraceLog(LOG_ERROR, "could not load sound, slot is not empty (file name : %s) (index : %i)", fileName, index);
-        return 0;
-    }
-	
-	Sound sound = LoadSound(fileName);
-	
-	if (!sound.frameCount)
-    {
-		TraceLog(LOG_ERROR, "failed to load sound, invalid file name (file name : %s) (index : %i)", fileName, index);
-		return 0;
-    }
-	
-	sounds[index] = sound;
-	TraceLog(LOG_INFO, "successfully loaded sound (file name : %s) (index : %i)", fileName, index);
-	
-	return index;
-}
-
-void OSAKA_UnloadSound(int index)
-{
-	if (index < 0 || index >= SOUNDS_LENGTH)
-    {
-        TraceLog(LOG_ERROR, "could not unload sound, index out of bounds (index : %i) (sounds length : %i)", index, SOUNDS_LENGTH);
-        return;
-    }
-	
-	if (!sounds[index].frameCount)
-    {
-        TraceLog(LOG_ERROR, "could not unload sound, slot is empty (index : %i)", index);
-        return;
-    }
-	
-	UnloadSound(sounds[index]);
-    sounds[index] = (Sound){0};	// make index empty by reinitialising
-	
-	TraceLog(LOG_INFO, "successfully unloaded sound (index : %i)", index);
-}
-
-// music ---------------------------------------------------------------------------------------------------------------
-
-int OSAKA_LoadMusic(char fileName[PATH_CHARACTER_LENGTH], int index)
-{
-	if (index < 0 || index >= MUSIC_LENGTH)
-    {
-        TraceLog(LOG_ERROR, "could not load music, index out of bounds (file name : %s) (index : %i) (music length : %i)", fileName, index, MUSIC_LENGTH);
-        return 0;
-    }
-	
-	if (musicTracks[index].frameCount)
-    {
-        TraceLog(LOG_ERROR, "could not load music, slot is not empty (file name : %s) (index : %i)", fileName, index);
-        return 0;
-    }
-	
-	Music music = LoadMusicStream(fileName);
-	
-	if (!music.frameCount)
-    {
-		TraceLog(LOG_ERROR, "failed to load music, invalid file name (file name : %s) (index : %i)", fileName, index);
-		return 0;
-    }
-	
-	musicTracks[index] = music;
-	TraceLog(LOG_INFO, "successfully loaded music (file name : %s) (index : %i)", fileName, index);
-	
-	return index;
-}
-
-void OSAKA_UnloadMusic(int index)
-{
-	if (index < 0 || index >= MUSIC_LENGTH)
-    {
-        TraceLog(LOG_ERROR, "could not unload music, index out of bounds (index : %i) (music length : %i)", index, MUSIC_LENGTH);
-        return;
-    }
-	
-	if (!musicTracks[index].frameCount)
-    {
-        TraceLog(LOG_ERROR, "could not unload music, slot is empty (index : %i)", index);
-        return;
-    }
-	
-	UnloadMusicStream(musicTracks[index]);
-    musicTracks[index] = (Music){0};	// make index empty by reinitialising
-	
-	TraceLog(LOG_INFO, "successfully unloaded music (index : %i)", index);
-}
-
-// fonts ---------------------------------------------------------------------------------------------------------------
-
-int OSAKA_LoadFont(char fileName[PATH_CHARACTER_LENGTH], int index)
-{
-	if (index < 0 || index >= FONTS_LENGTH)
-    {
-        TraceLog(LOG_ERROR, "could not load font, index out of bounds (file name : %s) (index : %i) (fonts length : %i)", fileName, index, FONTS_LENGTH);
-        return 0;
-    }
-	
-	if (fonts[index].glyphCount)
-    {
-        TraceLog(LOG_ERROR, "could not load font, slot is not empty (file name : %s) (index : %i)", fileName, index);
-        return 0;
-    }
-	
-	Font font = LoadFont(fileName);
-	
-	if (!font.glyphCount)
-    {
-		TraceLog(LOG_ERROR, "failed to load font, invalid file name (file name : %s) (index : %i)", fileName, index);
-		return 0;
-    }
-	
-	fonts[index] = font;
-	TraceLog(LOG_INFO, "successfully loaded font (file name : %s) (index : %i)", fileName, index);
-	
-	return index;
-}
-
-void OSAKA_UnloadFont(int index)
-{
-	if (index < 0 || index >= FONTS_LENGTH)
-    {
-        TraceLog(LOG_ERROR, "could not unload font, index out of bounds (index : %i) (fonts length : %i)", index, FONTS_LENGTH);
-        return;
-    }
-	
-	if (!fonts[index].glyphCount)
-    {
-        TraceLog(LOG_ERROR, "could not unload font, slot is empty (index : %i)", index);
-        return;
-    }
-	
-	UnloadFont(fonts[index]);
-    fonts[index] = (Font){0};	// make index empty by reinitialising
-	
-	TraceLog(LOG_INFO, "successfully unloaded font (index : %i)", index);
-}
-
-// ---------------------------------------------------------------------------------------------------------------------
-
-void OSAKA_InitResources()
-{
-	OSAKA_LoadTexture(MISSING_TEXTURE_FILE_NAME, 0);
-	OSAKA_LoadSound(MISSING_SOUND_FILE_NAME, 0);
-	OSAKA_LoadMusic(MISSING_MUSIC_FILE_NAME, 0);
-	OSAKA_LoadFont(MISSING_FONT_FILE_NAME, 0);
-}
-
-void OSAKA_QuitResources()
-{
-	 // unload all textures
-    for (int i = 0; i < TEXTURES_LENGTH; i++) {
-        if (textures[i].id) {
-            UnloadTexture(textures[i]);
-            textures[i] = (Texture2D){0};  // reset the texture slot
-        }
-    }
-	
-	 TraceLog(LOG_INFO, "unloaded all textures");
-
-    // unload all sounds
-    for (int i = 0; i < SOUNDS_LENGTH; i++) {
-        if (sounds[i].frameCount) {
-            UnloadSound(sounds[i]);
-            sounds[i] = (Sound){0};  // reset the sound slot
-        }
-    }
-	
-	TraceLog(LOG_INFO, "unloaded all sounds");
-
-    // unload all music
-    for (int i = 0; i < MUSIC_LENGTH; i++) {
-        if (musicTracks[i].frameCount) {
-            UnloadMusicStream(musicTracks[i]);
-            musicTracks[i] = (Music){0};  // reset the music slot
-            }
-    }
-	
-	TraceLog(LOG_INFO, "unloaded all music");
-
-    // unload all fonts
-    for (int i = 0; i < FONTS_LENGTH; i++) {
-        if (fonts[i].glyphCount) {
-            UnloadFont(fonts[i]);
-            fonts[i] = (Font){0};  // reset the font slot
-        }
-    }
-	
-	TraceLog(LOG_INFO, "unloaded all fonts");
+#include "OSAKA.h"
+#include <string.h>
+
+Texture2D textures[TEXTURES_LENGTH];
+Sound sounds[SOUNDS_LENGTH];
+Music musicTracks[MUSIC_LENGTH];
+Font fonts[FONTS_LENGTH];
+
+Texture2D atlasPages[ATLAS_PAGES_LENGTH];
+
+static AssetPack assetPack;		// checked before going to disk, empty when there is no pack
+
+static long long soundPlayCounts[SOUNDS_LENGTH];
+
+typedef struct SoundVoice
+{
+	Sound sound;			// the loaded sound itself for the first voice, aliases of it for the rest
+	uint64_t started;		// nanoseconds
+	uint64_t ends;			// when it will have played out, worked out from its length rather than asking the mixer
+} SoundVoice;
+
+static SoundVoice soundVoices[SOUNDS_LENGTH][SOUND_VOICES_LENGTH];
+static int soundVoicesLength[SOUNDS_LENGTH];		// created, 0 while the slot is empty
+static int soundVoiceCaps[SOUNDS_LENGTH];
+static int soundPriorities[SOUNDS_LENGTH];
+static uint64_t soundDurations[SOUNDS_LENGTH];		// nanoseconds
+static long long soundPlayTicks[SOUNDS_LENGTH];	// tick the sound last started on
+static SoundStats soundStats;
+
+static char textureFileNames[TEXTURES_LENGTH][PATH_CHARACTER_LENGTH];	// kept so the atlas can read the pixels back in
+static bool atlasRegistered[TEXTURES_LENGTH];
+static AtlasRegion atlasRegions[TEXTURES_LENGTH];
+
+#define ASYNC_LOAD_TEXTURE 0
+#define ASYNC_LOAD_SOUND 1
+#define ASYNC_LOAD_MUSIC 2
+
+typedef struct AsyncLoad
+{
+	int handle;
+	int type;
+	int index;
+	int group;
+	int state;				// written by the worker under loadMutex until it is LOAD_STATE_DECODED
+	bool failed;
+	char fileName[PATH_CHARACTER_LENGTH];
+	
+	Image image;
+	Wave wave;
+	Music music;
+} AsyncLoad;
+
+static AsyncLoad asyncLoads[ASYNC_LOADS_LENGTH];
+static int asyncLoadsNext = 1;
+static int asyncLoadsDecoded;		// waiting on the main thread, guarded by loadMutex
+static JobPool* loadPool;
+static Mutex* loadMutex;
+static Condition* loadDecoded;
+
+// textures ------------------------------------------------------------------------------------------------------------
+
+int OSAKA_LoadTexture(char fileName[PATH_CHARACTER_LENGTH], int index)
+{
+	if (index < 0 || index >= TEXTURES_LENGTH)
+    {
+        TraceLog(LOG_ERROR, "could not load texture, index out of bounds (file name : %s) (index : %i) (textures length : %i)", fileName, index, TEXTURES_LENGTH);
+        return 0;
+    }
+	
+	if (textures[index].id)
+    {
+        TraceLog(LOG_ERROR, "could not load texture, slot is not empty (file name : %s) (index : %i)", fileName, index);
+        return 0;
+    }
+	
+	if (OSAKA_IsHeadless())
+	{
+		TraceLog(LOG_DEBUG, "skipped loading texture, running headless (file name : %s) (index : %i)", fileName, index);
+		return index;
+	}
+	
+	const AssetPackEntry* asset = OSAKA_FindAsset(&assetPack, fileName);
+	Texture2D texture;
+	
+	if (asset && asset->type == ASSET_TEXTURE)
+	{
+		// already in the format the gpu wants, straight from the mapped pack
+		Image image = { (void*)OSAKA_GetAssetData(&assetPack, asset), asset->width, asset->height, asset->mipmaps, asset->format };
+		texture = LoadTextureFromImage(image);
+	}
+	else
+	{
+		texture = LoadTexture(fileName);
+	}
+	
+	if (!texture.id)
+    {
+		TraceLog(LOG_ERROR, "failed to load texture, invalid file name (file name : %s) (index : %i)", fileName, index);
+		return 0;
+    }
+	
+	textures[index] = texture;
+	strncpy(textureFileNames[index], fileName, PATH_CHARACTER_LENGTH - 1);
+	TraceLog(LOG_INFO, "successfully loaded texture (file name : %s) (index : %i)", fileName, index);
+	
+	return index;
+}
+
+void OSAKA_UnloadTexture(int index)
+{
+	if (index < 0 || index >= TEXTURES_LENGTH)
+    {
+        TraceLog(LOG_ERROR, "could not unload texture, index out of bounds (index : %i) (textures length : %i)", index, TEXTURES_LENGTH);
+        return;
+    }
+	
+	if (!textures[index].id)
+    {
+        TraceLog(LOG_ERROR, "could not unload texture, slot is empty (index : %i)", index);
+        return;
+    }
+	
+	UnloadTexture(textures[index]);
+    textures[index] = (Texture2D){0};	// make index empty by reinitialising
+	textureFileNames[index][0] = '\0';
+	atlasRegions[index] = (AtlasRegion){0};
+	
+	TraceLog(LOG_INFO, "successfully unloaded texture (index : %i)", index);
+}
+
+// atlas ---------------------------------------------------------------------------------------------------------------
+
+void OSAKA_AddToAtlas(int index)
+{
+	if (index < 0 || index >= TEXTURES_LENGTH)
+    {
+        TraceLog(LOG_ERROR, "could not add texture to atlas, index out of bounds (index : %i) (textures length : %i)", index, TEXTURES_LENGTH);
+        return;
+    }
+	
+	atlasRegistered[index] = true;
+}
+
+void OSAKA_BuildAtlas()
+{
+	if (OSAKA_IsHeadless())
+	{
+		TraceLog(LOG_DEBUG, "skipped building atlas, running headless");
+		return;
+	}
+	
+	OSAKA_UnloadAtlas();
+	
+	Image images[TEXTURES_LENGTH] = {0};
+	int order[TEXTURES_LENGTH];
+	int orderLength = 0;
+	
+	for (int i = 0; i < TEXTURES_LENGTH; i++)
+	{
+		if (!atlasRegistered[i] || !textures[i].id) continue;
+		
+		const AssetPackEntry* asset = OSAKA_FindAsset(&assetPack, textureFileNames[i]);
+		
+		if (asset && asset->type == ASSET_TEXTURE)
+		{
+			images[i] = ImageCopy((Image){ (void*)OSAKA_GetAssetData(&assetPack, asset), asset->width, asset->height, asset->mipmaps, asset->format });
+		}
+		else
+		{
+			images[i] = LoadImage(textureFileNames[i]);
+		}
+		
+		if (!images[i].data)
+		{
+			TraceLog(LOG_ERROR, "could not add texture to atlas, failed to read it back (file name : %s) (index : %i)", textureFileNames[i], i);
+			continue;
+		}
+		
+		// tallest first so each shelf wastes as little height as possible
+		int j = orderLength++;
+		
+		while (j > 0 && images[order[j - 1]].height < images[i].height)
+		{
+			order[j] = order[j - 1];
+			j--;
+		}
+		
+		order[j] = i;
+	}
+	
+	Image pages[ATLAS_PAGES_LENGTH] = {0};
+	int pagesLength = 0;
+	int shelfX = 0, shelfY = 0, shelfHeight = 0;
+	
+	for (int i = 0; i < orderLength; i++)
+	{
+		int index = order[i];
+		Image* image = &images[index];
+		int width = image->width + ATLAS_PADDING;
+		int height = image->height + ATLAS_PADDING;
+		
+		if (width > ATLAS_PAGE_SIZE || height > ATLAS_PAGE_SIZE)
+		{
+			TraceLog(LOG_WARNING, "texture left out of atlas, bigger than a page (index : %i) (width : %i) (height : %i)", index, image->width, image->height);
+			continue;
+		}
+		
+		if (shelfX + width > ATLAS_PAGE_SIZE)
+		{
+			shelfY += shelfHeight;
+			shelfX = 0;
+			shelfHeight = 0;
+		}
+		
+		if (!pagesLength || shelfY + height > ATLAS_PAGE_SIZE)
+		{
+			if (pagesLength == ATLAS_PAGES_LENGTH)
+			{
+				TraceLog(LOG_WARNING, "texture left out of atlas, out of pages (index : %i) (pages length : %i)", index, ATLAS_PAGES_LENGTH);
+				continue;
+			}
+			
+			pages[pagesLength++] = GenImageColor(ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE, BLANK);
+			shelfX = shelfY = shelfHeight = 0;
+		}
+		
+		Rectangle source = { shelfX, shelfY, image->width, image->height };
+		
+		ImageDraw(&pages[pagesLength - 1], *image, (Rectangle){ 0, 0, image->width, image->height }, source, WHITE);
+		atlasRegions[index] = (AtlasRegion){ true, pagesLength - 1, source };
+		
+		shelfX += width;
+		if (height > shelfHeight) shelfHeight = height;
+	}
+	
+	// the last page only needs to be as tall as what is on it
+	if (pagesLength) ImageCrop(&pages[pagesLength - 1], (Rectangle){ 0, 0, ATLAS_PAGE_SIZE, shelfY + shelfHeight });
+	
+	for (int i = 0; i < pagesLength; i++)
+	{
+		atlasPages[i] = LoadTextureFromImage(pages[i]);
+		UnloadImage(pages[i]);
+		
+		TraceLog(LOG_INFO, "successfully built atlas page (page : %i) (width : %i) (height : %i)", i, atlasPages[i].width, atlasPages[i].height);
+	}
+	
+	for (int i = 0; i < TEXTURES_LENGTH; i++)
+	{
+		if (images[i].data) UnloadImage(images[i]);
+	}
+}
+
+void OSAKA_UnloadAtlas()
+{
+	for (int i = 0; i < ATLAS_PAGES_LENGTH; i++)
+	{
+		if (atlasPages[i].id) UnloadTexture(atlasPages[i]);
+		atlasPages[i] = (Texture2D){0};
+	}
+	
+	for (int i = 0; i < TEXTURES_LENGTH; i++)
+	{
+		atlasRegions[i] = (AtlasRegion){0};
+	}
+}
+
+Texture2D OSAKA_GetAtlasTexture(int index, Rectangle* source)
+{
+	if (index < 0 || index >= TEXTURES_LENGTH) index = 0;
+	
+	AtlasRegion* region = &atlasRegions[index];
+	
+	if (region->packed && atlasPages[region->page].id)
+	{
+		*source = region->source;
+		return atlasPages[region->page];
+	}
+	
+	*source = (Rectangle){ 0, 0, textures[index].width, textures[index].height };
+	return textures[index];
+}
+
+void OSAKA_DrawTexture(int index, Rectangle dest, Color tint)
+{
+	Rectangle source;
+	Texture2D texture = OSAKA_GetAtlasTexture(index, &source);
+	
+	DrawTexturePro(texture, source, dest, (Vector2){ 0, 0 }, 0.0f, tint);
+}
+
+// sounds --------------------------------------------------------------------------------------------------------------
+
+static void loadSoundVoices(int index)
+{
+	Sound sound = sounds[index];
+	int length = 1;
+	
+	soundVoices[index][0] = (SoundVoice){ sound, 0, 0 };
+	
+	// the aliases share the sound's samples, each only costs a mixer buffer
+	for (; length < SOUND_VOICES_LENGTH; length++)
+	{
+		Sound alias = LoadSoundAlias(sound);
+		
+		if (!alias.stream.buffer) break;
+		
+		soundVoices[index][length] = (SoundVoice){ alias, 0, 0 };
+	}
+	
+	if (length < SOUND_VOICES_LENGTH) TraceLog(LOG_WARNING, "could not create every sound voice (index : %i) (voices : %i)", index, length);
+	
+	soundVoicesLength[index] = length;
+	soundDurations[index] = sound.stream.sampleRate ? (uint64_t)sound.frameCount * 1000000000ull / sound.stream.sampleRate : 0;
+	soundPlayTicks[index] = -1;
+}
+
+static void unloadSoundVoices(int index)
+{
+	for (int i = 1; i < soundVoicesLength[index]; i++)
+	{
+		UnloadSoundAlias(soundVoices[index][i].sound);
+	}
+	
+	memset(soundVoices[index], 0, sizeof(soundVoices[index]));
+	soundVoicesLength[index] = 0;
+}
+
+static int playingVoices(uint64_t now)
+{
+	int playing = 0;
+	
+	for (int i = 0; i < SOUNDS_LENGTH; i++)
+	{
+		for (int j = 0; j < soundVoicesLength[i]; j++)
+		{
+			if (soundVoices[i][j].ends > now) playing++;
+		}
+	}
+	
+	return playing;
+}
+
+// the voice to cut for a sound of priority, the oldest of the least important sounds playing, NULL if they all matter more
+static SoundVoice* oldestVoice(uint64_t now, int priority)
+{
+	SoundVoice* oldest = NULL;
+	int oldestPriority = priority;
+	
+	for (int i = 0; i < SOUNDS_LENGTH; i++)
+	{
+		if (soundPriorities[i] > oldestPriority) continue;
+		
+		for (int j = 0; j < soundVoicesLength[i]; j++)
+		{
+			SoundVoice* voice = &soundVoices[i][j];
+			
+			if (voice->ends <= now) continue;
+			
+			if (!oldest || soundPriorities[i] < oldestPriority || voice->started < oldest->started)
+			{
+				oldest = voice;
+				oldestPriority = soundPriorities[i];
+			}
+		}
+	}
+	
+	return oldest;
+}
+
+int OSAKA_LoadSound(char fileName[PATH_CHARACTER_LENGTH], int index)
+{
+	if (index < 0 || index >= SOUNDS_LENGTH)
+    {
+        TraceLog(LOG_ERROR, "could not load sound, index out of bounds (index : %i) (sounds length : %i)", index, SOUNDS_LENGTH);
+        return 0;
+    }
+	
+	if (sounds[index].frameCount)
+    {
+        TraceLog(LOG_ERROR, "could not load sound, slot is not empty (file name : %s) (index : %i)", fileName, index);
+        return 0;
+    }
+	
+	if (OSAKA_IsHeadless())
+	{
+		TraceLog(LOG_DEBUG, "skipped loading sound, running headless (file name : %s) (index : %i)", fileName, index);
+		return index;
+	}
+	
+	const AssetPackEntry* asset = OSAKA_FindAsset(&assetPack, fileName);
+	Sound sound;
+	
+	if (asset && asset->type == ASSET_SOUND)
+	{
+		Wave wave = { asset->frameCount, asset->sampleRate, asset->sampleSize, asset->channels, (void*)OSAKA_GetAssetData(&assetPack, asset) };
+		sound = LoadSoundFromWave(wave);
+	}
+	else
+	{
+		sound = LoadSound(fileName);
+	}
+	
+	if (!sound.frameCount)
+    {
+		TraceLog(LOG_ERROR, "failed to load sound, invalid file name (file name : %s) (index : %i)", fileName, index);
+		return 0;
+    }
+	
+	sounds[index] = sound;
+	loadSoundVoices(index);
+	TraceLog(LOG_INFO, "successfully loaded sound (file name : %s) (index : %i)", fileName, index);
+	
+	return index;
+}
+
+void OSAKA_UnloadSound(int index)
+{
+	if (index < 0 || index >= SOUNDS_LENGTH)
+    {
+        TraceLog(LOG_ERROR, "could not unload sound, index out of bounds (index : %i) (sounds length : %i)", index, SOUNDS_LENGTH);
+        return;
+    }
+	
+	if (!sounds[index].frameCount)
+    {
+        TraceLog(LOG_ERROR, "could not unload sound, slot is empty (index : %i)", index);
+        return;
+    }
+	
+	unloadSoundVoices(index);
+	UnloadSound(sounds[index]);
+    sounds[index] = (Sound){0};	// make index empty by reinitialising
+	
+	TraceLog(LOG_INFO, "successfully unloaded sound (index : %i)", index);
+}
+
+void OSAKA_PlaySound(int index)
+{
+	if (index < 0 || index >= SOUNDS_LENGTH)
+    {
+        TraceLog(LOG_ERROR, "could not play sound, index out of bounds (index : %i) (sounds length : %i)", index, SOUNDS_LENGTH);
+        return;
+    }
+	
+	soundPlayCounts[index]++;
+	
+	if (OSAKA_IsHeadless() || !soundVoicesLength[index]) return;
+	
+	// the same sound started twice in one tick only sounds louder and costs another voice
+	long long tick = OSAKA_GetTickCount();
+	
+	if (soundPlayTicks[index] == tick)
+	{
+		soundStats.merged++;
+		return;
+	}
+	
+	uint64_t now = OSAKA_GetTimeNanoseconds();
+	int cap = soundVoiceCaps[index] < soundVoicesLength[index] ? soundVoiceCaps[index] : soundVoicesLength[index];
+	SoundVoice* voice = NULL;
+	SoundVoice* oldest = NULL;
+	
+	for (int i = 0; i < cap; i++)
+	{
+		SoundVoice* candidate = &soundVoices[index][i];
+		
+		if (candidate->ends <= now)
+		{
+			if (!voice) voice = candidate;
+		}
+		else if (!oldest || candidate->started < oldest->started)
+		{
+			oldest = candidate;
+		}
+	}
+	
+	if (!voice)
+	{
+		// at its cap, restarting its own oldest voice keeps the number playing the same
+		voice = oldest;
+		soundStats.stolen++;
+	}
+	else if (playingVoices(now) >= SOUND_MIXER_VOICES)
+	{
+		SoundVoice* victim = oldestVoice(now, soundPriorities[index]);
+		
+		if (!victim)
+		{
+			soundStats.dropped++;
+			return;
+		}
+		
+		StopSound(victim->sound);
+		victim->ends = 0;
+		soundStats.stolen++;
+	}
+	
+	PlaySound(voice->sound);
+	voice->started = now;
+	voice->ends = now + soundDurations[index];
+	soundPlayTicks[index] = tick;
+}
+
+void OSAKA_SetSoundVoices(int index, int voices, int priority)
+{
+	if (index < 0 || index >= SOUNDS_LENGTH)
+    {
+        TraceLog(LOG_ERROR, "could not set sound voices, index out of bounds (index : %i) (sounds length : %i)", index, SOUNDS_LENGTH);
+        return;
+    }
+	
+	if (voices < 1 || voices > SOUND_VOICES_LENGTH)
+	{
+		TraceLog(LOG_ERROR, "could not set sound voices, voices out of bounds (index : %i) (voices : %i) (sound voices length : %i)", index, voices, SOUND_VOICES_LENGTH);
+		return;
+	}
+	
+	soundVoiceCaps[index] = voices;
+	soundPriorities[index] = priority;
+}
+
+long long OSAKA_GetSoundPlayCount(int index)
+{
+	if (index < 0 || index >= SOUNDS_LENGTH) return 0;
+	
+	return soundPlayCounts[index];
+}
+
+SoundStats OSAKA_GetSoundStats()
+{
+	SoundStats stats = soundStats;
+	
+	stats.voices = playingVoices(OSAKA_GetTimeNanoseconds());
+	
+	return stats;
+}
+
+// music ---------------------------------------------------------------------------------------------------------------
+
+int OSAKA_LoadMusic(char fileName[PATH_CHARACTER_LENGTH], int index)
+{
+	if (index < 0 || index >= MUSIC_LENGTH)
+    {
+        TraceLog(LOG_ERROR, "could not load music, index out of bounds (file name : %s) (index : %i) (music length : %i)", fileName, index, MUSIC_LENGTH);
+        return 0;
+    }
+	
+	if (musicTracks[index].frameCount)
+    {
+        TraceLog(LOG_ERROR, "could not load music, slot is not empty (file name : %s) (index : %i)", fileName, index);
+        return 0;
+    }
+	
+	if (OSAKA_IsHeadless())
+	{
+		TraceLog(LOG_DEBUG, "skipped loading music, running headless (file name : %s) (index : %i)", fileName, index);
+		return index;
+	}
+	
+	const AssetPackEntry* asset = OSAKA_FindAsset(&assetPack, fileName);
+	Music music;
+	
+	// streamed straight out of the mapped pack, which stays open until every track is unloaded
+	if (asset && asset->type == ASSET_MUSIC)
+	{
+		music = LoadMusicStreamFromMemory(asset->extension, OSAKA_GetAssetData(&assetPack, asset), (int)asset->size);
+	}
+	else
+	{
+		music = LoadMusicStream(fileName);
+	}
+	
+	if (!music.frameCount)
+    {
+		TraceLog(LOG_ERROR, "failed to load music, invalid file name (file name : %s) (index : %i)", fileName, index);
+		return 0;
+    }
+	
+	musicTracks[index] = music;
+	TraceLog(LOG_INFO, "successfully loaded music (file name : %s) (index : %i)", fileName, index);
+	
+	return index;
+}
+
+void OSAKA_UnloadMusic(int index)
+{
+	if (index < 0 || index >= MUSIC_LENGTH)
+    {
+        TraceLog(LOG_ERROR, "could not unload music, index out of bounds (index : %i) (music length : %i)", index, MUSIC_LENGTH);
+        return;
+    }
+	
+	if (!musicTracks[index].frameCount)
+    {
+        TraceLog(LOG_ERROR, "could not unload music, slot is empty (index : %i)", index);
+        return;
+    }
+	
+	// the audio thread may still be feeding it
+	OSAKA_StopMusic(index);
+	OSAKA_FlushAudio();
+	
+	UnloadMusicStream(musicTracks[index]);
+    musicTracks[index] = (Music){0};	// make index empty by reinitialising
+	
+	TraceLog(LOG_INFO, "successfully unloaded music (index : %i)", index);
+}
+
+// fonts ---------------------------------------------------------------------------------------------------------------
+
+int OSAKA_LoadFont(char fileName[PATH_CHARACTER_LENGTH], int index)
+{
+	if (index < 0 || index >= FONTS_LENGTH)
+    {
+        TraceLog(LOG_ERROR, "could not load font, index out of bounds (file name : %s) (index : %i) (fonts length : %i)", fileName, index, FONTS_LENGTH);
+        return 0;
+    }
+	
+	if (fonts[index].glyphCount)
+    {
+        TraceLog(LOG_ERROR, "could not load font, slot is not empty (file name : %s) (index : %i)", fileName, index);
+        return 0;
+    }
+	
+	if (OSAKA_IsHeadless())
+	{
+		TraceLog(LOG_DEBUG, "skipped loading font, running headless (file name : %s) (index : %i)", fileName, index);
+		return index;
+	}
+	
+	const AssetPackEntry* asset = OSAKA_FindAsset(&assetPack, fileName);
+	Font font;
+	
+	if (asset && asset->type == ASSET_FONT)
+	{
+		font = LoadFontFromMemory(asset->extension, OSAKA_GetAssetData(&assetPack, asset), (int)asset->size, 32, NULL, 95);
+	}
+	else
+	{
+		font = LoadFont(fileName);
+	}
+	
+	if (!font.glyphCount)
+    {
+		TraceLog(LOG_ERROR, "failed to load font, invalid file name (file name : %s) (index : %i)", fileName, index);
+		return 0;
+    }
+	
+	fonts[index] = font;
+	TraceLog(LOG_INFO, "successfully loaded font (file name : %s) (index : %i)", fileName, index);
+	
+	return index;
+}
+
+void OSAKA_UnloadFont(int index)
+{
+	if (index < 0 || index >= FONTS_LENGTH)
+    {
+        TraceLog(LOG_ERROR, "could not unload font, index out of bounds (index : %i) (fonts length : %i)", index, FONTS_LENGTH);
+        return;
+    }
+	
+	if (!fonts[index].glyphCount)
+    {
+        TraceLog(LOG_ERROR, "could not unload font, slot is empty (index : %i)", index);
+        return;
+    }
+	
+	UnloadFont(fonts[index]);
+    fonts[index] = (Font){0};	// make index empty by reinitialising
+	
+	TraceLog(LOG_INFO, "successfully unloaded font (index : %i)", index);
+}
+
+// async ---------------------------------------------------------------------------------------------------------------
+
+static void decodeAsyncLoad(void* data)
+{
+	AsyncLoad* load = data;
+	
+	PROFILE_BEGIN("decode");
+	
+	switch (load->type)
+	{
+		case ASYNC_LOAD_TEXTURE:
+			load->image = LoadImage(load->fileName);
+			load->failed = !load->image.data;
+			break;
+		
+		case ASYNC_LOAD_SOUND:
+			load->wave = LoadWave(load->fileName);
+			load->failed = !load->wave.frameCount;
+			break;
+		
+		case ASYNC_LOAD_MUSIC:
+			// opening the decoder is the slow part, raylib guards its audio buffer list so this is safe off the main thread
+			load->music = LoadMusicStream(load->fileName);
+			load->failed = !load->music.frameCount;
+			break;
+	}
+	
+	PROFILE_END();
+	
+	OSAKA_LockMutex(loadMutex);
+	load->state = LOAD_STATE_DECODED;
+	asyncLoadsDecoded++;
+	OSAKA_BroadcastCondition(loadDecoded);
+	OSAKA_UnlockMutex(loadMutex);
+}
+
+static int queueAsyncLoad(int type, char fileName[PATH_CHARACTER_LENGTH], int index, int length, int group)
+{
+	if (index < 0 || index >= length)
+    {
+        TraceLog(LOG_ERROR, "could not queue load, index out of bounds (file name : %s) (index : %i) (length : %i)", fileName, index, length);
+        return 0;
+    }
+	
+	if (!loadMutex)
+	{
+		loadMutex = OSAKA_CreateMutex();
+		loadDecoded = OSAKA_CreateCondition();
+		
+		if (!loadMutex || !loadDecoded)
+		{
+			TraceLog(LOG_ERROR, "could not queue load, failed to create lock (file name : %s)", fileName);
+			return 0;
+		}
+	}
+	
+	int handle = asyncLoadsNext;
+	AsyncLoad* load = &asyncLoads[handle % ASYNC_LOADS_LENGTH];
+	
+	OSAKA_LockMutex(loadMutex);
+	bool busy = load->state == LOAD_STATE_QUEUED || load->state == LOAD_STATE_DECODED;
+	OSAKA_UnlockMutex(loadMutex);
+	
+	if (busy)
+	{
+		TraceLog(LOG_ERROR, "could not queue load, too many loads in flight (file name : %s) (loads length : %i)", fileName, ASYNC_LOADS_LENGTH);
+		return 0;
+	}
+	
+	asyncLoadsNext++;
+	
+	*load = (AsyncLoad){0};
+	load->handle = handle;
+	load->type = type;
+	load->index = index;
+	load->group = group;
+	load->state = LOAD_STATE_QUEUED;
+	strncpy(load->fileName, fileName, PATH_CHARACTER_LENGTH - 1);
+	
+	if (OSAKA_IsHeadless())
+	{
+		TraceLog(LOG_DEBUG, "skipped loading, running headless (file name : %s) (index : %i)", fileName, index);
+		load->state = LOAD_STATE_DONE;
+		return handle;
+	}
+	
+	if (OSAKA_FindAsset(&assetPack, fileName))
+	{
+		// already decoded in the pack, only the upload is left and that has to happen here anyway
+		int loaded = type == ASYNC_LOAD_TEXTURE ? OSAKA_LoadTexture(fileName, index) :
+			type == ASYNC_LOAD_SOUND ? OSAKA_LoadSound(fileName, index) : OSAKA_LoadMusic(fileName, index);
+		
+		load->state = loaded == index ? LOAD_STATE_DONE : LOAD_STATE_FAILED;
+		return handle;
+	}
+	
+	if (!loadPool)
+	{
+		int threads = OSAKA_GetProcessorCount() - 1;
+		
+		loadPool = OSAKA_CreateJobPool(threads < ASYNC_LOAD_THREADS_LENGTH ? threads : ASYNC_LOAD_THREADS_LENGTH);
+		
+		if (loadPool) TraceLog(LOG_INFO, "started asset loading threads (threads : %i)", OSAKA_GetJobPoolThreads(loadPool));
+	}
+	
+	// no threads to be had, decode it here and still hand it over through OSAKA_UpdateAsyncLoads
+	if (!loadPool || !OSAKA_PushJob(loadPool, decodeAsyncLoad, load)) decodeAsyncLoad(load);
+	
+	return handle;
+}
+
+int OSAKA_LoadTextureAsync(char fileName[PATH_CHARACTER_LENGTH], int index, int group)
+{
+	return queueAsyncLoad(ASYNC_LOAD_TEXTURE, fileName, index, TEXTURES_LENGTH, group);
+}
+
+int OSAKA_LoadSoundAsync(char fileName[PATH_CHARACTER_LENGTH], int index, int group)
+{
+	return queueAsyncLoad(ASYNC_LOAD_SOUND, fileName, index, SOUNDS_LENGTH, group);
+}
+
+int OSAKA_LoadMusicAsync(char fileName[PATH_CHARACTER_LENGTH], int index, int group)
+{
+	return queueAsyncLoad(ASYNC_LOAD_MUSIC, fileName, index, MUSIC_LENGTH, group);
+}
+
+int OSAKA_GetLoadState(int handle)
+{
+	if (handle <= 0 || handle >= asyncLoadsNext) return 0;
+	
+	AsyncLoad* load = &asyncLoads[handle % ASYNC_LOADS_LENGTH];
+	
+	if (load->handle != handle) return LOAD_STATE_DONE;
+	
+	OSAKA_LockMutex(loadMutex);
+	int state = load->state;
+	OSAKA_UnlockMutex(loadMutex);
+	
+	return state;
+}
+
+// uploads to the gpu and audio device have to happen here on the main thread
+static void finishAsyncLoad(AsyncLoad* load)
+{
+	const char* names[] = { "texture", "sound", "music" };
+	bool taken = false;
+	
+	if (!load->failed)
+	{
+		switch (load->type)
+		{
+			case ASYNC_LOAD_TEXTURE:
+				if (textures[load->index].id) break;
+				
+				textures[load->index] = LoadTextureFromImage(load->image);
+				strncpy(textureFileNames[load->index], load->fileName, PATH_CHARACTER_LENGTH - 1);
+				taken = textures[load->index].id;
+				break;
+			
+			case ASYNC_LOAD_SOUND:
+				if (sounds[load->index].frameCount) break;
+				
+				sounds[load->index] = LoadSoundFromWave(load->wave);
+				taken = sounds[load->index].frameCount;
+				if (taken) loadSoundVoices(load->index);
+				break;
+			
+			case ASYNC_LOAD_MUSIC:
+				if (musicTracks[load->index].frameCount) break;
+				
+				musicTracks[load->index] = load->music;
+				load->music = (Music){0};
+				taken = true;
+				break;
+		}
+		
+		if (!taken) TraceLog(LOG_ERROR, "could not load %s, slot is not empty (file name : %s) (index : %i)", names[load->type], load->fileName, load->index);
+	}
+	else
+	{
+		TraceLog(LOG_ERROR, "failed to load %s, invalid file name (file name : %s) (index : %i)", names[load->type], load->fileName, load->index);
+	}
+	
+	if (load->image.data) UnloadImage(load->image);
+	if (load->wave.data) UnloadWave(load->wave);
+	if (load->music.frameCount) UnloadMusicStream(load->music);
+	
+	load->image = (Image){0};
+	load->wave = (Wave){0};
+	load->music = (Music){0};
+	load->state = taken ? LOAD_STATE_DONE : LOAD_STATE_FAILED;
+	
+	if (taken) TraceLog(LOG_INFO, "successfully loaded %s (file name : %s) (index : %i)", names[load->type], load->fileName, load->index);
+}
+
+void OSAKA_UpdateAsyncLoads()
+{
+	if (!loadMutex) return;
+	
+	OSAKA_LockMutex(loadMutex);
+	
+	if (!asyncLoadsDecoded)
+	{
+		OSAKA_UnlockMutex(loadMutex);
+		return;
+	}
+	
+	OSAKA_UnlockMutex(loadMutex);
+	
+	for (int i = 0; i < ASYNC_LOADS_LENGTH; i++)
+	{
+		AsyncLoad* load = &asyncLoads[i];
+		
+		OSAKA_LockMutex(loadMutex);
+		bool decoded = load->state == LOAD_STATE_DECODED;
+		if (decoded) asyncLoadsDecoded--;
+		OSAKA_UnlockMutex(loadMutex);
+		
+		// the worker is done with it once it is decoded so it can be finished without the lock
+		if (decoded) finishAsyncLoad(load);
+	}
+}
+
+bool OSAKA_IsGroupLoaded(int group)
+{
+	if (!loadMutex) return true;
+	
+	bool loaded = true;
+	
+	OSAKA_LockMutex(loadMutex);
+	
+	for (int i = 0; i < ASYNC_LOADS_LENGTH && loaded; i++)
+	{
+		int state = asyncLoads[i].state;
+		
+		if (asyncLoads[i].group == group && (state == LOAD_STATE_QUEUED || state == LOAD_STATE_DECODED)) loaded = false;
+	}
+	
+	OSAKA_UnlockMutex(loadMutex);
+	
+	return loaded;
+}
+
+void OSAKA_WaitForGroup(int group)
+{
+	// hand over each load as soon as it is decoded so uploads overlap the decoding still going on
+	while (true)
+	{
+		OSAKA_UpdateAsyncLoads();
+		
+		if (OSAKA_IsGroupLoaded(group)) return;
+		
+		OSAKA_LockMutex(loadMutex);
+		while (!asyncLoadsDecoded) OSAKA_WaitCondition(loadDecoded, loadMutex);
+		OSAKA_UnlockMutex(loadMutex);
+	}
+}
+
+static void quitAsyncLoads()
+{
+	// let anything still decoding finish, then throw away what never got handed over
+	OSAKA_DestroyJobPool(loadPool);
+	loadPool = NULL;
+	
+	for (int i = 0; i < ASYNC_LOADS_LENGTH; i++)
+	{
+		AsyncLoad* load = &asyncLoads[i];
+		
+		if (load->image.data) UnloadImage(load->image);
+		if (load->wave.data) UnloadWave(load->wave);
+		if (load->music.frameCount) UnloadMusicStream(load->music);
+		
+		*load = (AsyncLoad){0};
+	}
+	
+	OSAKA_DestroyCondition(loadDecoded);
+	OSAKA_DestroyMutex(loadMutex);
+	loadDecoded = NULL;
+	loadMutex = NULL;
+	asyncLoadsDecoded = 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void OSAKA_InitResources()
+{
+	OSAKA_OpenAssetPack(&assetPack, ASSET_PACK_FILE_NAME);
+	
+	for (int i = 0; i < SOUNDS_LENGTH; i++)
+	{
+		soundVoiceCaps[i] = SOUND_VOICES_LENGTH;
+	}
+	
+	OSAKA_LoadTexture(MISSING_TEXTURE_FILE_NAME, 0);
+	OSAKA_LoadSound(MISSING_SOUND_FILE_NAME, 0);
+	OSAKA_LoadMusic(MISSING_MUSIC_FILE_NAME, 0);
+	OSAKA_LoadFont(MISSING_FONT_FILE_NAME, 0);
+}
+
+void OSAKA_QuitResources()
+{
+	quitAsyncLoads();
+	OSAKA_UnloadAtlas();
+	
+	 // unload all textures
+    for (int i = 0; i < TEXTURES_LENGTH; i++) {
+        if (textures[i].id) {
+            UnloadTexture(textures[i]);
+            textures[i] = (Texture2D){0};  // reset the texture slot
+        }
+    }
+	
+	 TraceLog(LOG_INFO, "unloaded all textures");
+
+    // unload all sounds
+    for (int i = 0; i < SOUNDS_LENGTH; i++) {
+        if (sounds[i].frameCount) {
+            unloadSoundVoices(i);
+            UnloadSound(sounds[i]);
+            sounds[i] = (Sound){0};  // reset the sound slot
+        }
+    }
+	
+	TraceLog(LOG_INFO, "unloaded all sounds");
+
+    // unload all music
+    for (int i = 0; i < MUSIC_LENGTH; i++) {
+        if (musicTracks[i].frameCount) {
+            UnloadMusicStream(musicTracks[i]);
+            musicTracks[i] = (Music){0};  // reset the music slot
+            }
+    }
+	
+	TraceLog(LOG_INFO, "unloaded all music");
+
+    // unload all fonts
+    for (int i = 0; i < FONTS_LENGTH; i++) {
+        if (fonts[i].glyphCount) {
+            UnloadFont(fonts[i]);
+            fonts[i] = (Font){0};  // reset the font slot
+        }
+    }
+	
+	TraceLog(LOG_INFO, "unloaded all fonts");
+	
+	// music may still have been streaming out of it up to here
+	OSAKA_CloseAssetPack(&assetPack);
 }
\ No newline at end of file
@@ -0,0 +1,255 @@
+#include "OSAKA.h"
+#include <string.h>
+#include <math.h>
+
+static unsigned int hashCell(int cellX, int cellY)
+{
+	return ((unsigned int)cellX * 73856093u ^ (unsigned int)cellY * 19349663u) & (SPATIAL_HASH_BUCKETS_LENGTH - 1);
+}
+
+static int compareIds(const void* a, const void* b)
+{
+	int x = *(const int*)a;
+	int y = *(const int*)b;
+	
+	return (x > y) - (x < y);
+}
+
+static void cellRange(SpatialHash* hash, Rectangle box, int* minX, int* minY, int* maxX, int* maxY)
+{
+	// inclusive on both edges so boxes that only touch still share a cell
+	*minX = (int)floorf(box.x / hash->cellSize);
+	*minY = (int)floorf(box.y / hash->cellSize);
+	*maxX = (int)floorf((box.x + box.width) / hash->cellSize);
+	*maxY = (int)floorf((box.y + box.height) / hash->cellSize);
+}
+
+static bool reserveItems(SpatialHash* hash, int id)
+{
+	if (id < hash->itemsCapacity) return true;
+	
+	int capacity = hash->itemsCapacity ? hash->itemsCapacity : 16;
+	while (capacity <= id) capacity *= 2;
+	
+	SpatialHashItem* items = realloc(hash->items, capacity * sizeof(SpatialHashItem));
+	
+	if (!items)
+	{
+		TraceLog(LOG_ERROR, "could not grow spatial hash, out of memory (id : %i)", id);
+		return false;
+	}
+	
+	memset(items + hash->itemsCapacity, 0, (capacity - hash->itemsCapacity) * sizeof(SpatialHashItem));
+	
+	hash->items = items;
+	hash->itemsCapacity = capacity;
+	
+	return true;
+}
+
+static void insertCell(SpatialHash* hash, int id, int cellX, int cellY)
+{
+	SpatialHashBucket* bucket = &hash->buckets[hashCell(cellX, cellY)];
+	
+	if (bucket->length == bucket->capacity)
+	{
+		int capacity = bucket->capacity ? bucket->capacity * 2 : 8;
+		SpatialHashEntry* entries = realloc(bucket->entries, capacity * sizeof(SpatialHashEntry));
+		
+		if (!entries)
+		{
+			TraceLog(LOG_ERROR, "could not grow spatial hash bucket, out of memory (id : %i)", id);
+			return;
+		}
+		
+		bucket->entries = entries;
+		bucket->capacity = capacity;
+	}
+	
+	bucket->entries[bucket->length++] = (SpatialHashEntry){ id, cellX, cellY };
+}
+
+static void removeCell(SpatialHash* hash, int id, int cellX, int cellY)
+{
+	SpatialHashBucket* bucket = &hash->buckets[hashCell(cellX, cellY)];
+	
+	for (int i = 0; i < bucket->length; i++)
+	{
+		SpatialHashEntry* entry = &bucket->entries[i];
+		
+		if (entry->id == id && entry->cellX == cellX && entry->cellY == cellY)
+		{
+			*entry = bucket->entries[--bucket->length];
+			return;
+		}
+	}
+}
+
+void OSAKA_InitSpatialHash(SpatialHash* hash, float cellSize)
+{
+	memset(hash, 0, sizeof(SpatialHash));
+	
+	hash->cellSize = cellSize > 0 ? cellSize : 1;
+}
+
+void OSAKA_FreeSpatialHash(SpatialHash* hash)
+{
+	for (int i = 0; i < SPATIAL_HASH_BUCKETS_LENGTH; i++)
+	{
+		free(hash->buckets[i].entries);
+	}
+	
+	free(hash->items);
+	free(hash->results);
+	
+	OSAKA_InitSpatialHash(hash, hash->cellSize);
+}
+
+void OSAKA_ClearSpatialHash(SpatialHash* hash)
+{
+	for (int i = 0; i < SPATIAL_HASH_BUCKETS_LENGTH; i++)
+	{
+		hash->buckets[i].length = 0;
+	}
+	
+	if (hash->items) memset(hash->items, 0, hash->itemsCapacity * sizeof(SpatialHashItem));
+}
+
+void OSAKA_UpdateSpatialHash(SpatialHash* hash, int id, Rectangle box)
+{
+	if (id < 0 || !reserveItems(hash, id)) return;
+	
+	SpatialHashItem* item = &hash->items[id];
+	int minX, minY, maxX, maxY;
+	
+	cellRange(hash, box, &minX, &minY, &maxX, &maxY);
+	
+	if (item->inserted && item->minX == minX && item->minY == minY && item->maxX == maxX && item->maxY == maxY) return;
+	
+	// only touch the cells that were left or entered
+	for (int y = minY; y <= maxY; y++)
+	{
+		for (int x = minX; x <= maxX; x++)
+		{
+			if (!item->inserted || x < item->minX || x > item->maxX || y < item->minY || y > item->maxY)
+			{
+				insertCell(hash, id, x, y);
+			}
+		}
+	}
+	
+	if (item->inserted)
+	{
+		for (int y = item->minY; y <= item->maxY; y++)
+		{
+			for (int x = item->minX; x <= item->maxX; x++)
+			{
+				if (x < minX || x > maxX || y < minY || y > maxY)
+				{
+					removeCell(hash, id, x, y);
+				}
+			}
+		}
+	}
+	
+	item->inserted = true;
+	item->minX = minX;
+	item->minY = minY;
+	item->maxX = maxX;
+	item->maxY = maxY;
+}
+
+void OSAKA_RemoveFromSpatialHash(SpatialHash* hash, int id)
+{
+	if (id < 0 || id >= hash->itemsCapacity || !hash->items[id].inserted) return;
+	
+	SpatialHashItem* item = &hash->items[id];
+	
+	for (int y = item->minY; y <= item->maxY; y++)
+	{
+		for (int x = item->minX; x <= item->maxX; x++)
+		{
+			removeCell(hash, id, x, y);
+		}
+	}
+	
+	item->inserted = false;
+}
+
+int OSAKA_QuerySpatialHash(SpatialHash* hash, Rectangle box, int** results)
+{
+	int minX, minY, maxX, maxY;
+	int length = 0;
+	
+	cellRange(hash, box, &minX, &minY, &maxX, &maxY);
+	
+	// ids spanning several cells are stamped the first time they are seen so they come out once
+	if (++hash->queryStamp == 0)
+	{
+		for (int i = 0; i < hash->itemsCapacity; i++) hash->items[i].queryStamp = 0;
+		hash->queryStamp = 1;
+	}
+	
+	for (int y = minY; y <= maxY; y++)
+	{
+		for (int x = minX; x <= maxX; x++)
+		{
+			SpatialHashBucket* bucket = &hash->buckets[hashCell(x, y)];
+			
+			for (int i = 0; i < bucket->length; i++)
+			{
+				SpatialHashEntry* entry = &bucket->entries[i];
+				
+				if (entry->cellX != x || entry->cellY != y) continue;
+				if (hash->items[entry->id].queryStamp == hash->queryStamp) continue;
+				
+				hash->items[entry->id].queryStamp = hash->queryStamp;
+				
+				if (length == hash->resultsCapacity)
+				{
+					int capacity = hash->resultsCapacity ? hash->resultsCapacity * 2 : 32;
+					int* grown = realloc(hash->results, capacity * sizeof(int));
+					
+					if (!grown)
+					{
+						TraceLog(LOG_ERROR, "could not grow spatial hash results, out of memory (results : %i)", length);
+						*results = hash->results;
+						return length;
+					}
+					
+					hash->results = grown;
+					hash->resultsCapacity = capacity;
+				}
+				
+				hash->results[length++] = entry->id;
+			}
+		}
+	}
+	
+	// callers rely on a stable order, ascending ids is one that does not depend on how the buckets were filled,
+	// a short list is cheaper to insert in place than to hand to qsort, a dense pile gets the O(k log k) sort
+	if (length > SPATIAL_HASH_INSERTION_SORT_LENGTH)
+	{
+		qsort(hash->results, length, sizeof(int), compareIds);
+	}
+	else
+	{
+		for (int i = 1; i < length; i++)
+		{
+			int id = hash->results[i];
+			int j = i - 1;
+			
+			while (j >= 0 && hash->results[j] > id)
+			{
+				hash->results[j + 1] = hash->results[j];
+				j--;
+			}
+			
+			hash->results[j + 1] = id;
+		}
+	}
+	
+	*results = hash->results;
+	
+	return length;
+}
\ No newline at end of file
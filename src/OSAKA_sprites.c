@@ -0,0 +1,200 @@
+#include "OSAKA.h"
+#include "rlgl.h"
+
+#define KEY_TEXTURE_MASK 0xffffffull
+
+typedef struct Sprite
+{
+	unsigned int texture;
+	float u0, v0, u1, v1;	// normalised, already swapped for flips
+	Rectangle dest;
+	Color tint;
+} Sprite;
+
+static Sprite* sprites;
+static uint64_t* keys;		// layer, texture and then submission order packed into one integer, the low half indexes sprites
+static int spritesLength, spritesCapacity;
+static bool batching;
+static bool warned;
+
+static SpriteStats stats;
+static SpriteStats lastFrameStats;
+
+static bool growSprites()
+{
+	int capacity = spritesCapacity ? spritesCapacity * 2 : SPRITES_LENGTH;
+	
+	Sprite* grownSprites = realloc(sprites, capacity * sizeof(Sprite));
+	if (!grownSprites) return false;
+	sprites = grownSprites;
+	
+	uint64_t* grownKeys = realloc(keys, capacity * sizeof(uint64_t));
+	if (!grownKeys) return false;
+	keys = grownKeys;
+	
+	spritesCapacity = capacity;
+	
+	return true;
+}
+
+static int compareKeys(const void* a, const void* b)
+{
+	uint64_t keyA = *(const uint64_t*)a;
+	uint64_t keyB = *(const uint64_t*)b;
+	
+	return (keyA > keyB) - (keyA < keyB);
+}
+
+void OSAKA_BeginSprites()
+{
+	spritesLength = 0;
+	batching = true;
+}
+
+void OSAKA_DrawSprite(int index, Rectangle dest, Color tint, int layer, int flip)
+{
+	Rectangle source;
+	Texture2D texture = OSAKA_GetAtlasTexture(index, &source);
+	
+	OSAKA_DrawSpriteTexture(texture, source, dest, tint, layer, flip);
+}
+
+void OSAKA_DrawSpriteTexture(Texture2D texture, Rectangle source, Rectangle dest, Color tint, int layer, int flip)
+{
+	if (!batching)
+	{
+		if (!warned) TraceLog(LOG_WARNING, "sprite drawn outside of OSAKA_BeginSprites and OSAKA_EndSprites, dropped (texture : %u)", texture.id);
+		warned = true;
+		return;
+	}
+	
+	if (!texture.id || !texture.width || !texture.height) return;
+	
+	if (spritesLength == spritesCapacity && !growSprites())
+	{
+		if (!warned) TraceLog(LOG_ERROR, "could not grow sprite batch, out of memory, extra sprites are dropped (length : %i)", spritesLength);
+		warned = true;
+		return;
+	}
+	
+	if (layer < 0) layer = 0;
+	else if (layer >= SPRITE_LAYERS_LENGTH) layer = SPRITE_LAYERS_LENGTH - 1;
+	
+	Sprite* sprite = &sprites[spritesLength];
+	
+	sprite->texture = texture.id;
+	sprite->u0 = source.x / texture.width;
+	sprite->v0 = source.y / texture.height;
+	sprite->u1 = (source.x + source.width) / texture.width;
+	sprite->v1 = (source.y + source.height) / texture.height;
+	sprite->dest = dest;
+	sprite->tint = tint;
+	
+	// mirrored by swapping the coordinates, so one texture covers both directions
+	if (flip & SPRITE_FLIP_X)
+	{
+		float u = sprite->u0;
+		sprite->u0 = sprite->u1;
+		sprite->u1 = u;
+	}
+	
+	if (flip & SPRITE_FLIP_Y)
+	{
+		float v = sprite->v0;
+		sprite->v0 = sprite->v1;
+		sprite->v1 = v;
+	}
+	
+	keys[spritesLength] = (uint64_t)layer << 56 | (texture.id & KEY_TEXTURE_MASK) << 32 | (uint32_t)spritesLength;
+	spritesLength++;
+}
+
+void OSAKA_EndSprites()
+{
+	if (!batching) return;
+	
+	batching = false;
+	
+	if (!spritesLength) return;
+	
+	// submissions usually come in order already, then there is nothing to sort
+	bool sorted = true;
+	
+	for (int i = 1; i < spritesLength && sorted; i++)
+	{
+		sorted = keys[i - 1] <= keys[i];
+	}
+	
+	if (!sorted) qsort(keys, spritesLength, sizeof(uint64_t), compareKeys);
+	
+	unsigned int texture = 0;
+	
+	for (int i = 0; i < spritesLength; i++)
+	{
+		const Sprite* sprite = &sprites[(uint32_t)keys[i]];
+		
+		// draws what is in the buffer and starts over, rlgl keeps the texture and mode across it
+		if (rlCheckRenderBatchLimit(4))
+		{
+			stats.flushes++;
+			stats.draws++;
+		}
+		
+		if (sprite->texture != texture)
+		{
+			if (texture) rlEnd();
+			
+			texture = sprite->texture;
+			stats.binds++;
+			stats.draws++;
+			
+			rlSetTexture(texture);
+			rlBegin(RL_QUADS);
+			rlNormal3f(0.0f, 0.0f, 1.0f);
+		}
+		
+		Rectangle dest = sprite->dest;
+		
+		rlColor4ub(sprite->tint.r, sprite->tint.g, sprite->tint.b, sprite->tint.a);
+		
+		rlTexCoord2f(sprite->u0, sprite->v0);
+		rlVertex2f(dest.x, dest.y);
+		
+		rlTexCoord2f(sprite->u0, sprite->v1);
+		rlVertex2f(dest.x, dest.y + dest.height);
+		
+		rlTexCoord2f(sprite->u1, sprite->v1);
+		rlVertex2f(dest.x + dest.width, dest.y + dest.height);
+		
+		rlTexCoord2f(sprite->u1, sprite->v0);
+		rlVertex2f(dest.x + dest.width, dest.y);
+	}
+	
+	rlEnd();
+	rlSetTexture(0);
+	
+	stats.sprites += spritesLength;
+	spritesLength = 0;
+}
+
+SpriteStats OSAKA_GetSpriteStats()
+{
+	return lastFrameStats;
+}
+
+void OSAKA_ResetSpriteStats()
+{
+	lastFrameStats = stats;
+	stats = (SpriteStats){0};
+}
+
+void OSAKA_QuitSprites()
+{
+	free(sprites);
+	free(keys);
+	
+	sprites = NULL;
+	keys = NULL;
+	spritesLength = spritesCapacity = 0;
+	batching = false;
+}
@@ -0,0 +1,117 @@
+#include "OSAKA.h"
+#include <string.h>
+
+static Font textFont(const Text* text)
+{
+	if (text->font >= 0 && text->font < FONTS_LENGTH && fonts[text->font].texture.id) return fonts[text->font];
+	
+	return GetFontDefault();
+}
+
+// the same placement DrawTextEx and DrawTextCodepoint use, worked out once instead of every frame
+static void shapeText(Text* text, Font font)
+{
+	text->glyphsLength = 0;
+	text->bounds = (Vector2){ 0, 0 };
+	text->shapedTexture = font.texture.id;
+	text->shaped = true;
+	
+	if (!font.glyphCount || !font.baseSize) return;
+	
+	float scale = text->size / font.baseSize;
+	float padding = font.glyphPadding;
+	float x = 0;
+	float y = 0;
+	
+	for (int i = 0; text->string[i];)
+	{
+		int codepointSize = 0;
+		int codepoint = GetCodepointNext(&text->string[i], &codepointSize);
+		
+		i += codepointSize > 0 ? codepointSize : 1;
+		
+		if (codepoint == '\n')
+		{
+			x = 0;
+			y += text->size + TEXT_LINE_GAP;
+			continue;
+		}
+		
+		int index = GetGlyphIndex(font, codepoint);
+		Rectangle rec = font.recs[index];
+		GlyphInfo glyph = font.glyphs[index];
+		
+		if (codepoint != ' ' && codepoint != '\t')
+		{
+			text->glyphs[text->glyphsLength++] = (TextGlyph){
+				{ rec.x - padding, rec.y - padding, rec.width + 2 * padding, rec.height + 2 * padding },
+				{ x + (glyph.offsetX - padding) * scale, y + (glyph.offsetY - padding) * scale,
+					(rec.width + 2 * padding) * scale, (rec.height + 2 * padding) * scale } };
+		}
+		
+		x += (glyph.advanceX ? glyph.advanceX : rec.width) * scale + text->spacing;
+		
+		if (x > text->bounds.x) text->bounds.x = x;
+	}
+	
+	text->bounds.y = y + text->size;
+}
+
+void OSAKA_InitText(Text* text, int font, float size, Color color, int layer)
+{
+	memset(text, 0, sizeof(Text));
+	
+	// DrawText never goes below 10 and spaces glyphs by a pixel for every 10
+	if (size < 10) size = 10;
+	
+	text->font = font;
+	text->size = size;
+	text->spacing = (int)size / 10;
+	text->color = color;
+	text->layer = layer;
+}
+
+bool OSAKA_SetText(Text* text, const char* string)
+{
+	if (!string) string = "";
+	
+	if (!strncmp(text->string, string, TEXT_CHARACTER_LENGTH - 1)) return false;
+	
+	size_t length = strlen(string);
+	
+	if (length >= TEXT_CHARACTER_LENGTH)
+	{
+		TraceLog(LOG_WARNING, "text too long, cut short (length : %zu) (max length : %i)", length, TEXT_CHARACTER_LENGTH - 1);
+		length = TEXT_CHARACTER_LENGTH - 1;
+	}
+	
+	memcpy(text->string, string, length);
+	text->string[length] = '\0';
+	text->shaped = false;
+	
+	return true;
+}
+
+void OSAKA_DrawText(Text* text, float x, float y)
+{
+	Font font = textFont(text);
+	
+	if (!text->shaped || text->shapedTexture != font.texture.id) shapeText(text, font);
+	
+	for (int i = 0; i < text->glyphsLength; i++)
+	{
+		TextGlyph* glyph = &text->glyphs[i];
+		
+		OSAKA_DrawSpriteTexture(font.texture, glyph->source,
+			(Rectangle){ x + glyph->dest.x, y + glyph->dest.y, glyph->dest.width, glyph->dest.height }, text->color, text->layer, 0);
+	}
+}
+
+Vector2 OSAKA_MeasureText(Text* text)
+{
+	Font font = textFont(text);
+	
+	if (!text->shaped || text->shapedTexture != font.texture.id) shapeText(text, font);
+	
+	return text->bounds;
+}
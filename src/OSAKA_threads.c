@@ -0,0 +1,414 @@
+#include "OSAKA_threads.h"
+#include <stdlib.h>
+
+#if defined(_WIN32)
+	#define WIN32_LEAN_AND_MEAN
+	#include <windows.h>
+#else
+	#include <pthread.h>
+	#include <unistd.h>
+	#include <time.h>
+	#include <errno.h>
+#endif
+
+struct Mutex
+{
+#if defined(_WIN32)
+	CRITICAL_SECTION handle;
+#else
+	pthread_mutex_t handle;
+#endif
+};
+
+struct Condition
+{
+#if defined(_WIN32)
+	CONDITION_VARIABLE handle;
+#else
+	pthread_cond_t handle;
+#endif
+};
+
+struct Thread
+{
+#if defined(_WIN32)
+	HANDLE handle;
+#else
+	pthread_t handle;
+#endif
+	void (*function)(void* data);
+	void* data;
+};
+
+typedef struct Job
+{
+	void (*job)(void* data);
+	void* data;
+} Job;
+
+struct JobPool
+{
+	Thread* threads[JOB_POOL_THREADS_LENGTH];
+	int threadsLength;
+	
+	Mutex* mutex;
+	Condition* pushed;		// a job was queued or the pool is stopping
+	Condition* finished;	// a job finished
+	
+	Job* jobs;				// ring buffer
+	int jobsFirst, jobsLength, jobsCapacity;
+	int running;			// taken off the queue but not finished yet
+	bool stopping;
+};
+
+// mutex ---------------------------------------------------------------------------------------------------------------
+
+Mutex* OSAKA_CreateMutex()
+{
+	Mutex* mutex = malloc(sizeof(Mutex));
+	
+	if (!mutex) return NULL;
+	
+#if defined(_WIN32)
+	InitializeCriticalSection(&mutex->handle);
+#else
+	pthread_mutex_init(&mutex->handle, NULL);
+#endif
+	
+	return mutex;
+}
+
+void OSAKA_DestroyMutex(Mutex* mutex)
+{
+	if (!mutex) return;
+	
+#if defined(_WIN32)
+	DeleteCriticalSection(&mutex->handle);
+#else
+	pthread_mutex_destroy(&mutex->handle);
+#endif
+	
+	free(mutex);
+}
+
+void OSAKA_LockMutex(Mutex* mutex)
+{
+#if defined(_WIN32)
+	EnterCriticalSection(&mutex->handle);
+#else
+	pthread_mutex_lock(&mutex->handle);
+#endif
+}
+
+void OSAKA_UnlockMutex(Mutex* mutex)
+{
+#if defined(_WIN32)
+	LeaveCriticalSection(&mutex->handle);
+#else
+	pthread_mutex_unlock(&mutex->handle);
+#endif
+}
+
+// condition -----------------------------------------------------------------------------------------------------------
+
+Condition* OSAKA_CreateCondition()
+{
+	Condition* condition = malloc(sizeof(Condition));
+	
+	if (!condition) return NULL;
+	
+#if defined(_WIN32)
+	InitializeConditionVariable(&condition->handle);
+#else
+	pthread_cond_init(&condition->handle, NULL);
+#endif
+	
+	return condition;
+}
+
+void OSAKA_DestroyCondition(Condition* condition)
+{
+	if (!condition) return;
+	
+#if !defined(_WIN32)
+	pthread_cond_destroy(&condition->handle);
+#endif
+	
+	free(condition);
+}
+
+void OSAKA_WaitCondition(Condition* condition, Mutex* mutex)
+{
+#if defined(_WIN32)
+	SleepConditionVariableCS(&condition->handle, &mutex->handle, INFINITE);
+#else
+	pthread_cond_wait(&condition->handle, &mutex->handle);
+#endif
+}
+
+void OSAKA_SignalCondition(Condition* condition)
+{
+#if defined(_WIN32)
+	WakeConditionVariable(&condition->handle);
+#else
+	pthread_cond_signal(&condition->handle);
+#endif
+}
+
+void OSAKA_BroadcastCondition(Condition* condition)
+{
+#if defined(_WIN32)
+	WakeAllConditionVariable(&condition->handle);
+#else
+	pthread_cond_broadcast(&condition->handle);
+#endif
+}
+
+// thread --------------------------------------------------------------------------------------------------------------
+
+#if defined(_WIN32)
+static DWORD WINAPI threadMain(LPVOID data)
+{
+	Thread* thread = data;
+	thread->function(thread->data);
+	return 0;
+}
+#else
+static void* threadMain(void* data)
+{
+	Thread* thread = data;
+	thread->function(thread->data);
+	return NULL;
+}
+#endif
+
+Thread* OSAKA_CreateThread(void (*function)(void* data), void* data)
+{
+	Thread* thread = malloc(sizeof(Thread));
+	
+	if (!thread) return NULL;
+	
+	thread->function = function;
+	thread->data = data;
+	
+#if defined(_WIN32)
+	thread->handle = CreateThread(NULL, 0, threadMain, thread, 0, NULL);
+	
+	if (!thread->handle)
+	{
+		free(thread);
+		return NULL;
+	}
+#else
+	if (pthread_create(&thread->handle, NULL, threadMain, thread))
+	{
+		free(thread);
+		return NULL;
+	}
+#endif
+	
+	return thread;
+}
+
+void OSAKA_JoinThread(Thread* thread)
+{
+	if (!thread) return;
+	
+#if defined(_WIN32)
+	WaitForSingleObject(thread->handle, INFINITE);
+	CloseHandle(thread->handle);
+#else
+	pthread_join(thread->handle, NULL);
+#endif
+	
+	free(thread);
+}
+
+int OSAKA_GetProcessorCount()
+{
+#if defined(_WIN32)
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return info.dwNumberOfProcessors > 0 ? (int)info.dwNumberOfProcessors : 1;
+#elif defined(_SC_NPROCESSORS_ONLN)
+	long count = sysconf(_SC_NPROCESSORS_ONLN);
+	return count > 0 ? (int)count : 1;
+#else
+	return 1;
+#endif
+}
+
+uint64_t OSAKA_GetTimeNanoseconds()
+{
+#if defined(_WIN32)
+	static LARGE_INTEGER frequency;
+	LARGE_INTEGER counter;
+	
+	if (!frequency.QuadPart) QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&counter);
+	
+	// split so the multiply cannot overflow for long uptimes
+	return (uint64_t)(counter.QuadPart / frequency.QuadPart) * 1000000000ull +
+		(uint64_t)(counter.QuadPart % frequency.QuadPart) * 1000000000ull / frequency.QuadPart;
+#else
+	struct timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	
+	return (uint64_t)time.tv_sec * 1000000000ull + time.tv_nsec;
+#endif
+}
+
+void OSAKA_SleepNanoseconds(uint64_t nanoseconds)
+{
+#if defined(_WIN32)
+	// as fine as the system timer, a millisecond once raylib has asked for it
+	Sleep((DWORD)((nanoseconds + 999999) / 1000000));
+#else
+	struct timespec time = { (time_t)(nanoseconds / 1000000000ull), (long)(nanoseconds % 1000000000ull) };
+	
+	// woken early by a signal, sleeps out the rest
+	while (nanosleep(&time, &time) == -1 && errno == EINTR)
+	{
+	}
+#endif
+}
+
+// job pool ------------------------------------------------------------------------------------------------------------
+
+static void jobPoolWorker(void* data)
+{
+	JobPool* pool = data;
+	
+	OSAKA_LockMutex(pool->mutex);
+	
+	while (true)
+	{
+		while (!pool->jobsLength && !pool->stopping) OSAKA_WaitCondition(pool->pushed, pool->mutex);
+		
+		if (!pool->jobsLength) break;	// stopping and nothing left
+		
+		Job job = pool->jobs[pool->jobsFirst];
+		pool->jobsFirst = (pool->jobsFirst + 1) % pool->jobsCapacity;
+		pool->jobsLength--;
+		pool->running++;
+		
+		OSAKA_UnlockMutex(pool->mutex);
+		job.job(job.data);
+		OSAKA_LockMutex(pool->mutex);
+		
+		pool->running--;
+		OSAKA_BroadcastCondition(pool->finished);
+	}
+	
+	OSAKA_UnlockMutex(pool->mutex);
+}
+
+JobPool* OSAKA_CreateJobPool(int threadsLength)
+{
+	if (threadsLength < 1) threadsLength = 1;
+	if (threadsLength > JOB_POOL_THREADS_LENGTH) threadsLength = JOB_POOL_THREADS_LENGTH;
+	
+	JobPool* pool = calloc(1, sizeof(JobPool));
+	
+	if (!pool) return NULL;
+	
+	pool->mutex = OSAKA_CreateMutex();
+	pool->pushed = OSAKA_CreateCondition();
+	pool->finished = OSAKA_CreateCondition();
+	
+	if (!pool->mutex || !pool->pushed || !pool->finished)
+	{
+		OSAKA_DestroyJobPool(pool);
+		return NULL;
+	}
+	
+	for (int i = 0; i < threadsLength; i++)
+	{
+		pool->threads[pool->threadsLength] = OSAKA_CreateThread(jobPoolWorker, pool);
+		
+		if (pool->threads[pool->threadsLength]) pool->threadsLength++;
+	}
+	
+	if (!pool->threadsLength)
+	{
+		OSAKA_DestroyJobPool(pool);
+		return NULL;
+	}
+	
+	return pool;
+}
+
+bool OSAKA_PushJob(JobPool* pool, void (*job)(void* data), void* data)
+{
+	OSAKA_LockMutex(pool->mutex);
+	
+	if (pool->jobsLength == pool->jobsCapacity)
+	{
+		int capacity = pool->jobsCapacity ? pool->jobsCapacity * 2 : 32;
+		Job* jobs = malloc(capacity * sizeof(Job));
+		
+		if (!jobs)
+		{
+			OSAKA_UnlockMutex(pool->mutex);
+			return false;
+		}
+		
+		// unwrap the ring into the new buffer
+		for (int i = 0; i < pool->jobsLength; i++)
+		{
+			jobs[i] = pool->jobs[(pool->jobsFirst + i) % pool->jobsCapacity];
+		}
+		
+		free(pool->jobs);
+		pool->jobs = jobs;
+		pool->jobsFirst = 0;
+		pool->jobsCapacity = capacity;
+	}
+	
+	pool->jobs[(pool->jobsFirst + pool->jobsLength) % pool->jobsCapacity] = (Job){ job, data };
+	pool->jobsLength++;
+	
+	OSAKA_SignalCondition(pool->pushed);
+	OSAKA_UnlockMutex(pool->mutex);
+	
+	return true;
+}
+
+void OSAKA_WaitJobPool(JobPool* pool)
+{
+	OSAKA_LockMutex(pool->mutex);
+	
+	while (pool->jobsLength || pool->running) OSAKA_WaitCondition(pool->finished, pool->mutex);
+	
+	OSAKA_UnlockMutex(pool->mutex);
+}
+
+void OSAKA_DestroyJobPool(JobPool* pool)
+{
+	if (!pool) return;
+	
+	if (pool->mutex && pool->pushed)
+	{
+		OSAKA_LockMutex(pool->mutex);
+		pool->stopping = true;
+		OSAKA_BroadcastCondition(pool->pushed);
+		OSAKA_UnlockMutex(pool->mutex);
+	}
+	
+	for (int i = 0; i < pool->threadsLength; i++)
+	{
+		OSAKA_JoinThread(pool->threads[i]);
+	}
+	
+	OSAKA_DestroyCondition(pool->finished);
+	OSAKA_DestroyCondition(pool->pushed);
+	OSAKA_DestroyMutex(pool->mutex);
+	
+	free(pool->jobs);
+	free(pool);
+}
+
+int OSAKA_GetJobPoolThreads(JobPool* pool)
+{
+	return pool ? pool->threadsLength : 0;
+}
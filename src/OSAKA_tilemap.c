@@ -0,0 +1,381 @@
+#include "OSAKA.h"
+#include <string.h>
+#include <math.h>
+
+bool OSAKA_InitTilemap(Tilemap* map, int width, int height, int tileSize, const unsigned char* source)
+{
+	memset(map, 0, sizeof(Tilemap));
+	
+	if (width <= 0 || height <= 0 || tileSize <= 0)
+	{
+		TraceLog(LOG_ERROR, "could not create tilemap, size must be positive (width : %i) (height : %i) (tile size : %i)", width, height, tileSize);
+		return false;
+	}
+	
+	map->chunksWidth = (width + TILEMAP_CHUNK_SIZE - 1) / TILEMAP_CHUNK_SIZE;
+	map->chunksHeight = (height + TILEMAP_CHUNK_SIZE - 1) / TILEMAP_CHUNK_SIZE;
+	map->chunks = calloc((size_t)map->chunksWidth * map->chunksHeight, sizeof(TilemapChunk*));
+	
+	if (!map->chunks)
+	{
+		TraceLog(LOG_ERROR, "could not create tilemap, out of memory (width : %i) (height : %i)", width, height);
+		return false;
+	}
+	
+	map->width = width;
+	map->height = height;
+	map->tileSize = tileSize;
+	map->source = source;
+	
+	return true;
+}
+
+// only a chunk that has been drawn holds a texture, so maps that are never drawn never touch gl
+static void freeChunk(TilemapChunk* chunk)
+{
+	if (!chunk) return;
+	
+	if (chunk->baked.id) UnloadRenderTexture(chunk->baked);
+	
+	free(chunk);
+}
+
+void OSAKA_FreeTilemap(Tilemap* map)
+{
+	for (int i = 0; i < map->chunksWidth * map->chunksHeight; i++)
+	{
+		freeChunk(map->chunks[i]);
+	}
+	
+	free(map->chunks);
+	
+	memset(map, 0, sizeof(Tilemap));
+}
+
+static TilemapChunk* loadChunk(Tilemap* map, int chunkX, int chunkY)
+{
+	TilemapChunk** slot = &map->chunks[chunkY * map->chunksWidth + chunkX];
+	
+	if (*slot) return *slot;
+	
+	TilemapChunk* chunk = calloc(1, sizeof(TilemapChunk));
+	
+	if (!chunk)
+	{
+		TraceLog(LOG_ERROR, "could not load tilemap chunk, out of memory (chunk x : %i) (chunk y : %i)", chunkX, chunkY);
+		return NULL;
+	}
+	
+	if (map->source)
+	{
+		int left = chunkX * TILEMAP_CHUNK_SIZE;
+		int top = chunkY * TILEMAP_CHUNK_SIZE;
+		int columns = map->width - left < TILEMAP_CHUNK_SIZE ? map->width - left : TILEMAP_CHUNK_SIZE;
+		int rows = map->height - top < TILEMAP_CHUNK_SIZE ? map->height - top : TILEMAP_CHUNK_SIZE;
+		
+		// a row at a time, a mapped source only pages in the rows this chunk covers
+		for (int y = 0; y < rows; y++)
+		{
+			memcpy(&chunk->tiles[y * TILEMAP_CHUNK_SIZE], map->source + (size_t)(top + y) * map->width + left, columns);
+		}
+	}
+	
+	chunk->lastUsed = map->streams;
+	
+	*slot = chunk;
+	map->chunksLoaded++;
+	
+	return chunk;
+}
+
+unsigned char OSAKA_GetTile(Tilemap* map, int x, int y)
+{
+	if (x < 0 || y < 0 || x >= map->width || y >= map->height) return 0;
+	
+	TilemapChunk* chunk = map->chunks[(y / TILEMAP_CHUNK_SIZE) * map->chunksWidth + x / TILEMAP_CHUNK_SIZE];
+	
+	if (!chunk && !(chunk = loadChunk(map, x / TILEMAP_CHUNK_SIZE, y / TILEMAP_CHUNK_SIZE))) return 0;
+	
+	chunk->lastUsed = map->streams;
+	
+	return chunk->tiles[(y % TILEMAP_CHUNK_SIZE) * TILEMAP_CHUNK_SIZE + x % TILEMAP_CHUNK_SIZE];
+}
+
+void OSAKA_SetTile(Tilemap* map, int x, int y, unsigned char tile)
+{
+	if (x < 0 || y < 0 || x >= map->width || y >= map->height) return;
+	
+	TilemapChunk* chunk = loadChunk(map, x / TILEMAP_CHUNK_SIZE, y / TILEMAP_CHUNK_SIZE);
+	
+	if (!chunk) return;
+	
+	unsigned char* cell = &chunk->tiles[(y % TILEMAP_CHUNK_SIZE) * TILEMAP_CHUNK_SIZE + x % TILEMAP_CHUNK_SIZE];
+	
+	if (*cell == tile) return;
+	
+	*cell = tile;
+	chunk->dirty = true;
+	chunk->stale = true;
+	chunk->lastUsed = map->streams;
+}
+
+int OSAKA_SaveTilemapEdits(Tilemap* map, TilemapEdit* edits)
+{
+	int editsLength = 0;
+	
+	for (int i = 0; i < map->chunksWidth * map->chunksHeight; i++)
+	{
+		TilemapChunk* chunk = map->chunks[i];
+		
+		if (!chunk || !chunk->dirty) continue;
+		
+		if (edits)
+		{
+			edits[editsLength].chunk = i;
+			memcpy(edits[editsLength].tiles, chunk->tiles, TILEMAP_CHUNK_CELLS);
+		}
+		
+		editsLength++;
+	}
+	
+	return editsLength;
+}
+
+bool OSAKA_LoadTilemapEdits(Tilemap* map, const TilemapEdit* edits, int editsLength)
+{
+	int chunksLength = map->chunksWidth * map->chunksHeight;
+	
+	// everything that can fail is done before the map is touched, so a failed load leaves it as it was
+	for (int i = 0; i < editsLength; i++)
+	{
+		if (edits[i].chunk < 0 || edits[i].chunk >= chunksLength)
+		{
+			TraceLog(LOG_ERROR, "could not load tilemap edit, chunk out of bounds (chunk : %i) (chunks length : %i)", edits[i].chunk, chunksLength);
+			return false;
+		}
+	}
+	
+	// the whole chunk is written by its edit, so the ones not loaded yet never need their source
+	TilemapChunk** allocated = editsLength > 0 ? calloc((size_t)editsLength, sizeof(TilemapChunk*)) : NULL;
+	
+	if (editsLength > 0 && !allocated)
+	{
+		TraceLog(LOG_ERROR, "could not load tilemap edits, out of memory (edits length : %i)", editsLength);
+		return false;
+	}
+	
+	for (int i = 0; i < editsLength; i++)
+	{
+		if (map->chunks[edits[i].chunk]) continue;
+		
+		allocated[i] = calloc(1, sizeof(TilemapChunk));
+		
+		if (!allocated[i])
+		{
+			TraceLog(LOG_ERROR, "could not load tilemap edits, out of memory (edits length : %i)", editsLength);
+			
+			for (int j = 0; j < i; j++)
+			{
+				free(allocated[j]);
+			}
+			
+			free(allocated);
+			return false;
+		}
+	}
+	
+	// chunks about to be written over are kept, marked clean for a moment so they are not dropped below
+	for (int i = 0; i < editsLength; i++)
+	{
+		if (map->chunks[edits[i].chunk]) map->chunks[edits[i].chunk]->dirty = false;
+	}
+	
+	// clean chunks already match the source, only the changed ones have to go
+	for (int i = 0; i < chunksLength; i++)
+	{
+		TilemapChunk* chunk = map->chunks[i];
+		
+		if (!chunk || !chunk->dirty) continue;
+		
+		freeChunk(chunk);
+		map->chunks[i] = NULL;
+		map->chunksLoaded--;
+	}
+	
+	for (int i = 0; i < editsLength; i++)
+	{
+		TilemapChunk** slot = &map->chunks[edits[i].chunk];
+		
+		if (!*slot && allocated[i])
+		{
+			*slot = allocated[i];
+			map->chunksLoaded++;
+		}
+		else free(allocated[i]);		// the same chunk edited twice, the later edit wins
+		
+		memcpy((*slot)->tiles, edits[i].tiles, TILEMAP_CHUNK_CELLS);
+		(*slot)->lastUsed = map->streams;
+		(*slot)->dirty = true;
+		(*slot)->stale = true;
+	}
+	
+	free(allocated);
+	
+	return true;
+}
+
+// chunk range under a box in world units, clamped to the map, false when it misses the map entirely
+static bool chunkRange(Tilemap* map, Rectangle area, int* minX, int* minY, int* maxX, int* maxY)
+{
+	float chunkSize = (float)map->tileSize * TILEMAP_CHUNK_SIZE;
+	
+	*minX = (int)floorf(area.x / chunkSize);
+	*minY = (int)floorf(area.y / chunkSize);
+	*maxX = (int)floorf((area.x + area.width) / chunkSize);
+	*maxY = (int)floorf((area.y + area.height) / chunkSize);
+	
+	if (*minX < 0) *minX = 0;
+	if (*minY < 0) *minY = 0;
+	if (*maxX > map->chunksWidth - 1) *maxX = map->chunksWidth - 1;
+	if (*maxY > map->chunksHeight - 1) *maxY = map->chunksHeight - 1;
+	
+	return *minX <= *maxX && *minY <= *maxY;
+}
+
+void OSAKA_StreamTilemap(Tilemap* map, Rectangle area)
+{
+	if (!map->chunks) return;
+	
+	map->streams++;
+	
+	int minX, minY, maxX, maxY;
+	
+	if (chunkRange(map, area, &minX, &minY, &maxX, &maxY))
+	{
+		for (int y = minY; y <= maxY; y++)
+		{
+			for (int x = minX; x <= maxX; x++)
+			{
+				TilemapChunk* chunk = loadChunk(map, x, y);
+				
+				if (chunk) chunk->lastUsed = map->streams;
+			}
+		}
+	}
+	
+	// anything read since the last stream was marked by OSAKA_GetTile, so only chunks nobody needs go
+	for (int i = 0; i < map->chunksWidth * map->chunksHeight; i++)
+	{
+		TilemapChunk* chunk = map->chunks[i];
+		
+		if (!chunk || chunk->dirty || map->streams - chunk->lastUsed <= TILEMAP_EVICT_STREAMS) continue;
+		
+		freeChunk(chunk);
+		map->chunks[i] = NULL;
+		map->chunksLoaded--;
+	}
+}
+
+// false when a tile texture has not finished loading, the chunk is then baked again on the next draw
+static bool bakeChunk(Tilemap* map, TilemapChunk* chunk, int columns, int rows, const int* tileTextures, int tileTexturesLength)
+{
+	bool complete = true;
+	
+	BeginTextureMode(chunk->baked);
+	ClearBackground(BLANK);
+	
+	for (int y = 0; y < rows; y++)
+	{
+		for (int x = 0; x < columns; x++)
+		{
+			unsigned char tile = chunk->tiles[y * TILEMAP_CHUNK_SIZE + x];
+			
+			if (tile >= tileTexturesLength) continue;
+			
+			Rectangle source;
+			Texture2D texture = OSAKA_GetAtlasTexture(tileTextures[tile], &source);
+			
+			if (!texture.id)
+			{
+				complete = false;
+				continue;
+			}
+			
+			DrawTexturePro(texture, source, (Rectangle){ x * map->tileSize, y * map->tileSize, map->tileSize, map->tileSize }, (Vector2){ 0, 0 }, 0.0f, WHITE);
+		}
+	}
+	
+	EndTextureMode();
+	
+	return complete;
+}
+
+void OSAKA_DrawTilemap(Tilemap* map, Camera2D camera, int screenWidth, int screenHeight, const int* tileTextures, int tileTexturesLength, int layer)
+{
+	if (!map->chunks || camera.zoom <= 0) return;
+	
+	map->draws++;
+	
+	// the camera is never rotated, so the view is the screen scaled back into world units
+	Rectangle view = {
+		camera.target.x - camera.offset.x / camera.zoom, camera.target.y - camera.offset.y / camera.zoom,
+		screenWidth / camera.zoom, screenHeight / camera.zoom };
+	
+	int minX, minY, maxX, maxY;
+	bool baked = false;
+	
+	if (chunkRange(map, view, &minX, &minY, &maxX, &maxY))
+	{
+		for (int y = minY; y <= maxY; y++)
+		{
+			for (int x = minX; x <= maxX; x++)
+			{
+				TilemapChunk* chunk = loadChunk(map, x, y);
+				
+				if (!chunk) continue;
+				
+				chunk->lastUsed = map->streams;
+				chunk->lastDrawn = map->draws;
+				
+				// chunks on the right and bottom edges only cover what is left of the map
+				int columns = map->width - x * TILEMAP_CHUNK_SIZE < TILEMAP_CHUNK_SIZE ? map->width - x * TILEMAP_CHUNK_SIZE : TILEMAP_CHUNK_SIZE;
+				int rows = map->height - y * TILEMAP_CHUNK_SIZE < TILEMAP_CHUNK_SIZE ? map->height - y * TILEMAP_CHUNK_SIZE : TILEMAP_CHUNK_SIZE;
+				Rectangle area = { x * TILEMAP_CHUNK_SIZE * map->tileSize, y * TILEMAP_CHUNK_SIZE * map->tileSize, columns * map->tileSize, rows * map->tileSize };
+				
+				if (!chunk->baked.id)
+				{
+					chunk->baked = LoadRenderTexture((int)area.width, (int)area.height);
+					chunk->stale = true;
+					
+					if (!chunk->baked.id)
+					{
+						TraceLog(LOG_ERROR, "could not bake tilemap chunk, failed to create render texture (chunk x : %i) (chunk y : %i)", x, y);
+						continue;
+					}
+				}
+				
+				if (chunk->stale)
+				{
+					chunk->stale = !bakeChunk(map, chunk, columns, rows, tileTextures, tileTexturesLength);
+					baked = true;
+				}
+				
+				// render textures come out upside down
+				OSAKA_DrawSpriteTexture(chunk->baked.texture, (Rectangle){ 0, 0, area.width, area.height }, area, WHITE, layer, SPRITE_FLIP_Y);
+			}
+		}
+	}
+	
+	if (baked) BeginMode2D(camera);
+	
+	// a chunk can stay loaded long after it leaves the view, its texture does not have to
+	for (int i = 0; i < map->chunksWidth * map->chunksHeight; i++)
+	{
+		TilemapChunk* chunk = map->chunks[i];
+		
+		if (!chunk || !chunk->baked.id || map->draws - chunk->lastDrawn <= TILEMAP_RELEASE_DRAWS) continue;
+		
+		UnloadRenderTexture(chunk->baked);
+		chunk->baked = (RenderTexture2D){0};
+	}
+}
@@ -1,1319 +1,3372 @@
-#include "OSAKA.h"
-#include <string.h>
-#include <math.h>
-#include <stdio.h>
-
-#define LIVE_ENTITY_LENGTH 10
-
-#define TILE_SIZE 64
-#define GRID_WIDTH 19
-#define GRID_HEIGHT 13
-#define FRICTION 0.02
-#define GRAVITY 9.8
-#define TERMINAL_VELOCITY 500
-
-typedef unsigned char uchar;
-typedef unsigned short ushort;
-typedef unsigned int uint;
-typedef unsigned long ulong;
-typedef unsigned long long ullong;
-
-typedef struct LiveEnt LiveEnt;
-
-void liveEntUpdate(LiveEnt* ent);
-void liveEntRender(LiveEnt* ent);
-bool checkCollision(LiveEnt* ent, LiveEnt* collider);
-bool checkTileCollision(LiveEnt* ent, int tileX, int tileY);
-
-void playerUpdate(LiveEnt* ent);
-void playerOnXCollision(LiveEnt* ent, LiveEnt* collider);
-void playerOnYCollision(LiveEnt* ent, LiveEnt* collider);
-void playerOnTileXCollision(LiveEnt* ent, int tileX, int tileY);
-void playerOnTileYCollision(LiveEnt* ent, int tileX, int tileYr);
-
-void runeOnXCollision(LiveEnt* ent, LiveEnt* collider);
-void runeOnYCollision(LiveEnt* ent, LiveEnt* collider);
-void runeOnPlayerCollision(LiveEnt* ent, LiveEnt* collider);
-
-void monsterUpdate(LiveEnt* ent);
-
-LiveEnt createPlayer(int index,int x, int y, int width, int height);
-
-LiveEnt createMonster(int index, int x, int y, int width, int height);
-
-LiveEnt createPlatform(int index,int x, int y, int width, int height);
-
-LiveEnt createItem(int index,int x, int y, float scaleX, float scaleY);
-
-void level1();
-void level2();
-void level3();
-void level4();
-void level5();
-void level6();
-void level7();
-void level8();
-void level9();
-void level10();
-void level11();
-void menu();
-
-void init();
-void update();
-void render();
-void quit();
-
-void (*levels[12])() = {level1, level2, level3, level4, level5, level6, level7, level8, level9, level10, level11, menu};
-int currentLevel;
-bool initLevel;
-bool isHard;
-bool viewingStory;
-bool viewingAnalysis;
-
-float atime;
-
-// grid ----------------------------------------------------------------------------------------------------------------
-
-int grid[GRID_HEIGHT][GRID_WIDTH];
-
-// entity --------------------------------------------------------------------------------------------------------------
-
-struct LiveEnt
-{
-	int index;
-	bool initialised;
-	bool facingRight;
-	int flippedIndex;
-	int type;
-	float scaleX, scaleY;
-	float x, y, dx, dy, ddx, ddy, fx, fy;
-	bool onGround;
-	float width, height;
-	int imageIndex;
-	
-	void (*update)(LiveEnt* ent);
-	void (*render)(LiveEnt* ent);
-	
-	void (*onXCollision)(LiveEnt* ent, LiveEnt* collider);
-    void (*onYCollision)(LiveEnt* ent, LiveEnt* collider);
-	void (*onTileXCollision)(LiveEnt* ent, int tileX, int tileY);
-    void (*onTileYCollision)(LiveEnt* ent, int tileX, int tileY);
-};
-
-LiveEnt liveEnts[LIVE_ENTITY_LENGTH];
-LiveEnt* selectedRune;
-
-void liveEntUpdate(LiveEnt* ent)
-{
-	
-	// Apply friction to horizontal movement
-    ent->dx *= (1 - FRICTION);
-	ent->dy *= (1 - FRICTION);
-    
-    // Update acceleration based on force and mass
-    uint mass = ((ent->width + ent->height))/7;
-	
-	if (currentLevel ==8) mass = ((ent->width + ent->height) + 20)/7;
-	
-	if (mass < 10 && ent->type == 0) mass = 15;
-	
-    ent->ddx = ent->fx / mass;
-    ent->ddy = ent->fy / mass;
-
-    // Apply acceleration to velocity
-    ent->dx += ent->ddx * GetFrameTime();
-    ent->dy += (ent->ddy + GRAVITY) * GetFrameTime();
-
-    // Apply terminal velocity to prevent infinite falling speed
-    if (ent->dy > TERMINAL_VELOCITY) {
-        ent->dy = TERMINAL_VELOCITY;
-    }
-	
-	if (ent->dy < 0) ent->onGround = false;
-
-    ent->x += ent->dx;
-
-	// check for collisions with other entities
-    for (int i = 0; i < LIVE_ENTITY_LENGTH; i++)
-	{
-        if (&liveEnts[i] != ent && liveEnts[i].initialised)
-		{
-            if (checkCollision(ent, &liveEnts[i]))
-            {
-                ent->onXCollision(ent, &liveEnts[i]);
-            }
-        }
-    }
-
-    // check for tile collisions
-    for (int x = 0; x < GRID_WIDTH; x++)
-	{
-        for (int y = 0; y < GRID_HEIGHT; y++)
-		{
-            if (grid[y][x] && checkTileCollision(ent, x , y))
-            {
-                ent->onTileXCollision(ent, x, y);
-            }
-        }
-    }
-	
-	
-    ent->y += ent->dy;  
-
-	// check for collisions with other entities
-    for (int i = 0; i < LIVE_ENTITY_LENGTH; i++)
-	{
-        if (&liveEnts[i] != ent && liveEnts[i].initialised)
-		{
-            if (checkCollision(ent, &liveEnts[i]))
-            {
-                ent->onYCollision(ent, &liveEnts[i]);
-            }
-        }
-    }
-
-    // check for tile collisions
-    for (int x = 0; x < GRID_WIDTH; x++)
-	{
-        for (int y = 0; y < GRID_HEIGHT; y++)
-		{
-            if (grid[y][x] && checkTileCollision(ent, x , y))
-            {
-                ent->onTileYCollision(ent, x, y);
-            }
-        }
-    }       
-	
-	// boundaries
-	if (ent->x < 0)
-	{
-		ent->x = 0;
-	}
-	else if (ent->x > 1216 - ent->width)
-	{
-		if (ent->type || (currentLevel == 9 && liveEnts[7].initialised) || currentLevel == 10)
-		{
-			ent->x = 1216 - ent->width;
-		}
-		else
-		{
-			currentLevel++;
-			initLevel = true;
-		}
-	}
-	
-	if (ent->y < 0)
-	{
-		ent->y = 0;
-	}
-	else if (ent->y > 832 - ent->height)
-	{
-		ent->y = 832 - ent->height;
-	}
-
-	// reset forces for next frame
-    ent->fx = 0;
-    ent->fy = 0;
-}
-
-void liveEntRender(LiveEnt* ent)
-{
-	DrawTexturePro(
-        textures[ent->facingRight ? ent->imageIndex : ent->flippedIndex],
-        (Rectangle){ 0, 0, textures[ent->imageIndex].width, textures[ent->imageIndex].height },
-        (Rectangle){ ent->x, ent->y, ent->width+2, ent->height+2 },
-        (Vector2){ 0, 0 },
-        0.0f,
-        WHITE
-    );
-}
-
-bool checkCollision(LiveEnt* ent, LiveEnt* collider)
-{
-    float entLeft = ent->x;
-    float entRight = ent->x + ent->width;
-    float entTop = ent->y;
-    float entBottom = ent->y + ent->height;
-
-    float colliderLeft = collider->x;
-    float colliderRight = collider->x + collider->width;
-    float colliderTop = collider->y;
-    float colliderBottom = collider->y + collider->height;
-
-    // true if theres no gaps between then on x or y
-    return !((entRight < colliderLeft || colliderRight < entLeft) ||
-		(entBottom < colliderTop || colliderBottom < entTop));
-}
-
-bool checkTileCollision(LiveEnt* ent, int tileX, int tileY)
-{
-    // Calculate tile boundaries directly
-    float tileLeft = tileX * TILE_SIZE;
-    float tileTop = tileY * TILE_SIZE;
-
-    // Calculate entity boundaries
-    float entRight = ent->x + ent->width;
-    float entBottom = ent->y + ent->height;
-
-    // Check for overlap (no need for tileRight and tileBottom)
-    return !(entRight <= tileLeft || ent->x >= tileLeft + TILE_SIZE ||
-             entBottom <= tileTop || ent->y >= tileTop + TILE_SIZE);
-}
-
-
-// player --------------------------------------------------------------------------------------------------------------
-
-void playerUpdate(LiveEnt* ent)
-{
-    if (IsKeyDown(KEY_A) || IsKeyDown(KEY_LEFT)){
-		ent->fx = -100;
-		ent->facingRight = false;
-	}
-    if (IsKeyDown(KEY_D) || IsKeyDown(KEY_RIGHT)) {
-		ent->fx = 100;
-		ent->facingRight = true;
-	}
-	if ((IsKeyDown(KEY_W) || IsKeyDown(KEY_SPACE) || IsKeyDown(KEY_UP)) && ent->onGround)
-	{
-		ent->fy = -15000;
-		
-	}
-	
-	if (selectedRune)
-	{
-		selectedRune->x = ent->facingRight ? ent->x + ent->width : ent->x - selectedRune->width;
-		selectedRune->y = ent->y;
-	}
-	
-	if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && selectedRune)
-	{
-		selectedRune->fx = ent->facingRight ? 2500 : -2500;
-		selectedRune->fy = -3000;
-		
-		selectedRune = NULL;
-		
-		PlaySound(sounds[3]);
-	}
-	
-	if (IsMouseButtonPressed(MOUSE_RIGHT_BUTTON) && selectedRune)
-	{
-		ent->width *= selectedRune->scaleX;
-		ent->height *= selectedRune->scaleY;
-		liveEnts[selectedRune->index] = (LiveEnt){0};;
-		selectedRune = NULL;
-		
-		PlaySound(sounds[2]);
-	}
-	
-	if (IsKeyDown(KEY_R))
-	{
-		initLevel = true;
-	}
-	
-	viewingAnalysis = IsKeyDown(KEY_H);
-	
-	// remove later
-	//if (IsKeyDown(KEY_G))
-	//{
-//		currentLevel = (sizeof(levels) / sizeof(levels[0])) -1;
-//initLevel = true;
-//	}
-}
-
-void playerOnXCollision(LiveEnt* ent, LiveEnt* collider)
-{
-	if (collider->type == 1 && ent->type == 0) return;
-	
-	if (ent->type == 0 && collider->type ==3)
-	{
-		if ((ent->width + ent->height) > (collider->width + collider->height))
-		{
-			liveEnts[collider->index] = (LiveEnt){0};
-			PlaySound(sounds[4]);
-		}
-		else
-		{
-			initLevel = true;
-			if (isHard) currentLevel = 0;
-			PlaySound(sounds[4]);
-		}
-		return;
-	}
-	
-	if (ent->type == 3 && collider->type ==0)
-	{
-		if ((ent->width + ent->height) < (collider->width + collider->height))
-		{
-			
-			ent->initialised = false;
-			ent->x= 99999999;
-			
-			PlaySound(sounds[4]);
-		}
-		else
-		{
-			initLevel = true;
-			if (isHard) currentLevel = 0;
-			PlaySound(sounds[4]);
-		}
-		return;
-	}
-	
-	if (collider->type == 1)
-	{
-		if (collider == selectedRune) return;
-		
-		if (collider->scaleY > 1)
-		{
-			ent->y -= ent->height;
-		}
-		
-		ent->width *= collider->scaleX;
-		ent->height *= collider->scaleY;
-		liveEnts[collider->index] = (LiveEnt){0};
-		PlaySound(sounds[2]);
-		return;
-	}
-	
-    if (ent->dx > 0) {  // Moving right
-        ent->x = collider->x - ent->width - ent->dx;
-		if (ent->type==3) ent->facingRight = false;
-    } else if (ent->dx < 0) {  // Moving left
-        ent->x = collider->x + collider->width - ent->dx;
-		if (ent->type==3)ent->facingRight = true;
-    }
-    ent->dx = 0;  // Stop horizontal movement on collision
-    ent->fx = 0;  // Reset horizontal force
-}
-
-void playerOnYCollision(LiveEnt* ent, LiveEnt* collider)
-{
-	if (collider->type == 1 && ent->type == 0) return;
-	
-	if (ent->type == 0 && collider->type ==3)
-	{
-		if ((ent->width + ent->height) > (collider->width + collider->height))
-		{
-			liveEnts[collider->index] = (LiveEnt){0};
-			PlaySound(sounds[4]);
-		}
-		else
-		{
-			initLevel = true;
-			if (isHard) currentLevel = 0;
-			PlaySound(sounds[4]);
-		}
-		return;
-
-	}
-	
-	if (ent->type == 3 && collider->type ==0)
-	{
-		if ((ent->width + ent->height) < (collider->width + collider->height))
-		{
-			
-			ent->initialised = false;
-			ent->x= 99999999;
-			
-			PlaySound(sounds[4]);
-			
-		}
-		else
-		{
-			initLevel = true;
-			if (isHard) currentLevel = 0;
-			PlaySound(sounds[4]);
-		}
-		return;
-	}
-	
-	if (collider->type == 1)
-	{
-		if (collider == selectedRune) return;
-	
-		if (collider->scaleY > 1)
-		{
-			ent->y -= ent->height;
-		}
-	
-		ent->width *= collider->scaleX;
-		ent->height *= collider->scaleY;
-		liveEnts[collider->index] = (LiveEnt){0};
-		PlaySound(sounds[2]);
-		return;
-	}
-	
-	if (ent->dy > 0) {  // Falling down
-        ent->y = collider->y - ent->height - 2;
-        ent->onGround = true;  // Set a flag to indicate the entity is on the ground
-    } else if (ent->dy < 0) {  // Moving up (jumping)
-        ent->y = collider->y + collider->height - ent->dy;
-    }
-    ent->dy = 0;  // Stop vertical movement on collision
-    ent->fy = 0;  // Reset vertical force
-}
-
-void playerOnTileXCollision(LiveEnt* ent, int tileX, int tileY)
-{
-	if (ent == selectedRune) return;
-	
-	if (grid[tileY][tileX] == 1)
-	{
-		if (ent->dx > 0) {  // Moving right
-			ent->x = tileX*TILE_SIZE - ent->width - ent->dx;
-			
-			if (ent->type == 3)
-			{
-				ent->facingRight = false;
-			}
-		} else if (ent->dx < 0) {  // Moving left
-			ent->x = tileX*TILE_SIZE + TILE_SIZE - ent->dx;
-			
-			if (ent->type == 3)
-			{
-				ent->facingRight = true;
-			}
-		}
-		ent->dx = 0;  // Stop horizontal movement on collision
-		ent->fx = 0;  // Reset horizontal force
-	}
-	
-	if (grid[tileY][tileX] == 2 && ent->type != 2)
-	{
-		if (ent->type == 0)
-		{
-			initLevel = true;
-			if (isHard) currentLevel = 0;
-			PlaySound(sounds[4]);
-		}
-		else
-		{
-			ent->initialised = false;
-			ent->x= 99999999;
-			
-			PlaySound(sounds[4]);
-		}
-			
-		return;
-	}
-	
-	
-}
-
-void playerOnTileYCollision(LiveEnt* ent, int tileX, int tileY)
-{
-	if (ent == selectedRune) return;
-	
-	if (grid[tileY][tileX])
-	{
-		if (ent->dy > 0) {  // Falling down
-			ent->y = tileY*TILE_SIZE - ent->height - ent->dy;
-			ent->onGround = true;  // Set a flag to indicate the entity is on the ground
-		} else if (ent->dy < 0) {  // Moving up (jumping)
-			ent->y -= ent->dy;
-		}
-		ent->dy = 0;  // Stop vertical movement on collision
-		ent->fy = 0;  // Reset vertical force
-	}
-	
-	if (grid[tileY][tileX] == 2 && ent->type != 2)
-	{
-		if (ent->type == 0)
-		{
-			initLevel = true;
-			if (isHard) currentLevel = 0;
-			PlaySound(sounds[4]);
-		}
-		else
-		{
-			ent->initialised = false;
-			ent->x= 99999999;
-			PlaySound(sounds[4]);
-		}
-			
-		return;
-	}
-	
-	
-}
-
-void runeOnXCollision(LiveEnt* ent, LiveEnt* collider)
-{
-	if (!collider->type)
-	{
-		runeOnPlayerCollision(ent, collider);
-	}
-}
-
-void runeOnYCollision(LiveEnt* ent, LiveEnt* collider)
-{
-	if (!collider->type)
-	{
-		runeOnPlayerCollision(ent, collider);
-	}
-}
-
-void runeOnPlayerCollision(LiveEnt* ent, LiveEnt* collider)
-{
-	if (!selectedRune && IsKeyDown(KEY_E))
-	{
-		PlaySound(sounds[1]);
-		selectedRune = ent;
-	}
-}
-
-void monsterUpdate(LiveEnt* ent)
-{
-	ent->fx = ent->facingRight ? 200 : -200;
-}
-
-void wizardUpdate(LiveEnt* ent)
-{
-	LiveEnt* target = &liveEnts[0];
-	
-	// Calculate the direction vector from the follower to the target
-    float directionX = target->x - ent->x;
-    float directionY = target->y - ent->y;
-
-    // Calculate the distance between the two entities
-    float distance = sqrt(directionX * directionX + directionY * directionY);
-
-    // Normalize the direction vector
-    if (distance != 0) {
-        directionX /= distance;
-        directionY /= distance;
-    }
-
-    // Apply the direction vector to the follower's force, scaled by speed
-    ent->fx = directionX * 50;
-    ent->fy = directionY * 800;
-	
-	ent->facingRight = ent->fx > 0;
-	
-}
-
-
-
-// run -----------------------------------------------------------------------------------------------------------------
-
-int main(int argc, char *argv[])
-{
-	OSAKA_Run("RUNESCALER", 1216, 832, init, update, render, quit);
-
-    return 0;
-}
-
-void init()
-{
-	OSAKA_LoadTexture(TEXTURES_PATH "tile0.png", 1);
-	OSAKA_LoadTexture(TEXTURES_PATH "tile1.png", 2);
-	OSAKA_LoadTexture(TEXTURES_PATH "player.png", 3);
-	OSAKA_LoadTexture(TEXTURES_PATH "playerflipped.png", 4);
-	OSAKA_LoadTexture(TEXTURES_PATH "platform.png", 5);
-	OSAKA_LoadTexture(TEXTURES_PATH "2H.png", 6);
-	OSAKA_LoadTexture(TEXTURES_PATH "1H.png", 7);
-	OSAKA_LoadTexture(TEXTURES_PATH "2A.png", 8);
-	OSAKA_LoadTexture(TEXTURES_PATH "1A.png", 9);
-	OSAKA_LoadTexture(TEXTURES_PATH "2V.png", 10);
-	OSAKA_LoadTexture(TEXTURES_PATH "1V.png", 11);
-	OSAKA_LoadTexture(TEXTURES_PATH "monster.png", 12);
-	OSAKA_LoadTexture(TEXTURES_PATH "monsterflipped.png", 13);
-	OSAKA_LoadTexture(TEXTURES_PATH "spike.png", 14);
-	OSAKA_LoadTexture(TEXTURES_PATH "wizard.png", 15);
-	OSAKA_LoadTexture(TEXTURES_PATH "wizardflipped.png", 16);
-	OSAKA_LoadTexture(TEXTURES_PATH "end.png", 17);
-	OSAKA_LoadTexture(TEXTURES_PATH "menu.png", 18);
-	OSAKA_LoadTexture(TEXTURES_PATH "start.png", 19);
-	OSAKA_LoadTexture(TEXTURES_PATH "runeanalysis.png", 20);
-	
-	OSAKA_LoadMusic(MUSIC_PATH "music.mp3", 1);
-	OSAKA_LoadMusic(MUSIC_PATH "battlemusic.mp3", 2);
-	OSAKA_LoadMusic(MUSIC_PATH "menumusic.mp3", 3);
-	
-	OSAKA_LoadSound(SOUNDS_PATH "pickupCoin.wav", 1);
-	OSAKA_LoadSound(SOUNDS_PATH "powerUp.wav", 2);
-	OSAKA_LoadSound(SOUNDS_PATH "throw.wav", 3);
-	OSAKA_LoadSound(SOUNDS_PATH "death.wav", 4);
-	
-	PlayMusicStream(musicTracks[3]);
-	
-	currentLevel = 11;
-	initLevel = true;
-}
-
-void menu()
-{
-	// reset entities
-	for (int i = 0; i < LIVE_ENTITY_LENGTH; i++) {
-       liveEnts[i] = (LiveEnt){0};
-    }
-	
-	int levelgrid[GRID_HEIGHT][GRID_WIDTH] = {
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-		{1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}
-	};
-	
-	memcpy(grid, levelgrid, sizeof(levelgrid));
-}
-
-void level1()
-{
-	// reset entities
-	for (int i = 0; i < LIVE_ENTITY_LENGTH; i++) {
-       liveEnts[i] = (LiveEnt){0};
-    }
-	
-	liveEnts[0] = createPlayer(0,0,625, 126, 126);
-	liveEnts[1] = createItem(1, 300, 765, 1, 0.5);
-	
-	int levelgrid[GRID_HEIGHT][GRID_WIDTH] = {
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-		{1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}
-	};
-	
-	memcpy(grid, levelgrid, sizeof(levelgrid));
-}
-
-void level2()
-{
-	// reset entities
-	for (int i = 0; i < LIVE_ENTITY_LENGTH; i++) {
-       liveEnts[i] = (LiveEnt){0};
-    }
-	
-	liveEnts[0] = createPlayer(0,0,625, 62, 124);
-	liveEnts[1] = createItem(1, 1100, 700, 1, 0.5);
-	
-	int levelgrid[GRID_HEIGHT][GRID_WIDTH] = {
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-		{1,1,2,2,1,1,2,2,1,1,2,2,1,1,2,2,1,1,1}
-	};
-	
-	memcpy(grid, levelgrid, sizeof(levelgrid));
-	
-	PlaySound(sounds[2]);
-}
-
-void level3()
-{
-	// reset entities
-	for (int i = 0; i < LIVE_ENTITY_LENGTH; i++) {
-       liveEnts[i] = (LiveEnt){0};
-    }
-	
-	liveEnts[0] = createPlayer(0,0,700, 64, 60);
-	liveEnts[1] = createItem(1, 1100, 250, 1, 0.5);
-	liveEnts[2] = createPlatform(2,1152,700, 62, 114);
-	
-	int levelgrid[GRID_HEIGHT][GRID_WIDTH] = {
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,1,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,1,0,0,0,0,1,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,1,0,0,0,0,1,0,0,0,0,0,1},
-		{0,0,1,0,0,0,0,1,0,0,0,0,1,1,0,0,0,0,1},
-		{0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,0,0},
-		{0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,0,0},
-		{1,1,1,2,2,2,2,1,2,2,2,2,1,2,2,2,1,1,1}
-	};
-	
-	memcpy(grid, levelgrid, sizeof(levelgrid));
-}
-
-void level4()
-{
-	// reset entities
-	for (int i = 0; i < LIVE_ENTITY_LENGTH; i++) {
-       liveEnts[i] = (LiveEnt){0};
-    }
-
-	liveEnts[0] = createPlayer(0,0,700, 64, 62);
-    liveEnts[1] = createItem(1, 0, 0, 2, 1);
-	liveEnts[2] = createItem(2, 64, 0, 2, 1);
-	liveEnts[3] = createItem(3, 128, 0, 2, 1);
-    liveEnts[4] = createItem(4, 192, 0, 2, 1);
-	liveEnts[5] = createPlatform(5, 193, 765, 62,62);
-	
-	int levelgrid[GRID_HEIGHT][GRID_WIDTH] = {
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2},
-		{1,1,1,1,0,0,0,1,1,0,0,0,0,1,0,0,0,0,2},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2},
-		{0,0,0,0,0,1,1,0,0,0,0,0,1,1,0,0,0,0,2},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2},
-		{0,0,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-		{0,0,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-		{1,1,1,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2}
-	};
-	
-	memcpy(grid, levelgrid, sizeof(levelgrid));
-}
-
-void level5()
-{
-	// reset entities
-	for (int i = 0; i < LIVE_ENTITY_LENGTH; i++) {
-       liveEnts[i] = (LiveEnt){0};
-    }
-	
-	liveEnts[0] = createPlayer(0,0,700, 70, 30);
-	liveEnts[1] = createItem(1, 0, 0, 1, 2);
-	liveEnts[2] = createItem(2, 64, 0, 1, 0.5);
-	liveEnts[3] = createPlatform(3,1152,705, 62, 20);
-	liveEnts[4] = createMonster(4,900,700, 70, 34);
-	liveEnts[5] = createMonster(5,256,0, 70, 34);
-	
-	int levelgrid[GRID_HEIGHT][GRID_WIDTH] = {
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2},
-		{0,0,0,1,0,0,0,0,0,0,0,0,0,1,0,0,0,0,2},
-		{1,1,1,1,1,1,1,1,1,1,1,1,1,1,0,0,0,0,2},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,1,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,1,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,1,0,0,0,0,0,0},
-		{1,1,1,2,2,2,2,2,2,2,2,2,1,1,1,1,1,1,1}
-	};
-	
-	memcpy(grid, levelgrid, sizeof(levelgrid));
-	
-	PlaySound(sounds[2]);
-}
-
-
-
-
-void level6()
-{
-	// reset entities
-	for (int i = 0; i < LIVE_ENTITY_LENGTH; i++) {
-       liveEnts[i] = (LiveEnt){0};
-    }
-	
-	liveEnts[0] = createPlayer(0,0,0, 62, 62);
-	liveEnts[1] = createItem(1, 1080, 290, 1, 2);
-	liveEnts[2] = createMonster(2,256,380, 62, 62);
-	liveEnts[3] = createMonster(3,832,600, 124, 124);
-	liveEnts[4] = createMonster(4,256,650, 64, 60);
-
-	
-	int levelgrid[GRID_HEIGHT][GRID_WIDTH] = {
-		{0,0,0,0,0,0,0,2,0,0,0,0,0,2,0,0,0,0,1},
-		{0,0,0,0,2,0,0,0,0,0,2,0,0,0,0,0,0,0,1},
-		{1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,0,0,1},
-		{0,0,0,0,2,2,0,0,0,0,0,0,0,0,2,2,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,1,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1,1},
-		{0,0,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1},
-		{0,0,0,2,2,0,0,0,0,0,0,0,0,2,2,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,1,0,0,0,0,0,0,0,0,1,0,0,0,0,1,0,0},
-		{1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}
-	};
-	
-	memcpy(grid, levelgrid, sizeof(levelgrid));
-	
-	PlaySound(sounds[2]);
-}
-
-void level7()
-{
-	// reset entities
-	for (int i = 0; i < LIVE_ENTITY_LENGTH; i++) {
-       liveEnts[i] = (LiveEnt){0};
-    }
-	
-	liveEnts[0] = createPlayer(0,0,700, 60, 60);
-	liveEnts[1] = createMonster(1,832,0, 90, 63);
-	liveEnts[1].facingRight = false;
-	liveEnts[2] = createItem(2, 686, 384, 2, 2);
-	liveEnts[3] = createItem(3, 70, 320, 1, 0.5);
-
-	
-	int levelgrid[GRID_HEIGHT][GRID_WIDTH] = {
-		{1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,0,0,0,1},
-		{1,1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-		{1,1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{1,0,0,0,0,1,1,1,1,1,1,1,1,1,1,1,1,1,1},
-		{1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2},
-		{1,1,1,0,0,0,0,0,0,0,0,0,0,0,1,0,0,0,2},
-		{1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,0,0,0,2},
-		{0,0,0,0,0,2,0,0,0,0,0,0,0,0,0,0,0,0,2},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,1,1,1,0,0,2},
-		{0,0,0,0,0,0,0,0,0,1,1,0,0,1,1,1,0,0,2},
-		{1,1,2,2,1,1,1,2,2,1,1,2,2,1,1,1,2,2,2}
-	};
-	
-	memcpy(grid, levelgrid, sizeof(levelgrid));
-}
-
-void level8()
-{
-	// reset entities
-	for (int i = 0; i < LIVE_ENTITY_LENGTH; i++) {
-       liveEnts[i] = (LiveEnt){0};
-    }
-
-	liveEnts[0] = createPlayer(0,0,700, 59, 60);
-	liveEnts[1] = createPlatform(1,897 ,127, 58,630);
-	liveEnts[2] = createMonster(2,400,0, 110, 64);
-	liveEnts[3] = createMonster(3,600,0, 110, 64);
-	liveEnts[6] = createItem(6, 644, 320, 0.5, 1);
-	liveEnts[7] = createItem(7, 708, 320, 0.5, 1);
-	liveEnts[8] = createItem(8, 772, 320, 1, 0.5);
-	
-	int levelgrid[GRID_HEIGHT][GRID_WIDTH] = {
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-		{0,0,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,1,1,1,1,1,1,1,1,1,1,1,1,0,1,1,1,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,1,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,1,0,0,0,0,1},
-		{1,0,0,0,0,0,0,0,0,0,0,0,0,1,0,0,0,0,1},
-		{1,1,0,0,0,0,0,0,0,1,1,1,1,1,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{1,1,1,1,2,2,2,2,2,1,1,2,2,2,2,2,2,2,1}
-	};
-	
-	memcpy(grid, levelgrid, sizeof(levelgrid));
-	
-	PlaySound(sounds[2]);
-
-}
-
-
-void level9()
-{
-	// reset entities
-	for (int i = 0; i < LIVE_ENTITY_LENGTH; i++) {
-       liveEnts[i] = (LiveEnt){0};
-    }
-	
-	liveEnts[0] = createPlayer(0,0,700, 57, 57);
-	liveEnts[1] = createPlatform(1,1025,650, 26, 254);
-	liveEnts[2] = createMonster(2,385,630, 62, 124);
-	liveEnts[3] = createItem(3, 1100, 192, 2, 2);
-	liveEnts[4] = createItem(4,768, 700, 0.5, 0.5);
-	liveEnts[5] = createItem(5, 832, 700, 0.5, 1);
-	
-	int levelgrid[GRID_HEIGHT][GRID_WIDTH] = {
-		{2,0,0,0,0,0,0,0,2,0,0,0,0,0,0,0,0,0,1},
-		{2,0,0,0,0,0,0,0,2,0,0,0,0,0,0,0,0,0,1},
-		{2,0,0,0,0,0,0,0,2,0,0,0,0,0,0,0,0,0,1},
-		{2,0,0,0,2,0,0,0,2,0,0,0,0,0,0,0,0,0,1},
-		{1,1,0,0,2,0,0,0,1,1,1,1,0,0,2,2,2,1,1},
-		{2,0,0,0,2,0,0,0,2,0,0,0,0,0,0,0,0,0,1},
-		{2,0,0,0,2,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{2,0,0,0,2,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{2,0,0,1,1,1,0,0,1,1,1,1,1,1,1,1,0,1,1},
-		{2,0,0,0,1,0,0,0,0,0,0,0,0,0,0,1,0,0,1},
-		{0,0,0,0,1,0,0,0,0,0,0,0,0,0,0,1,0,0,1},
-		{0,0,0,0,1,0,0,0,0,1,0,0,0,0,0,1,0,0,0},
-		{1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}
-	};
-	
-	memcpy(grid, levelgrid, sizeof(levelgrid));
-}
-
-void level10()
-{
-	// reset entities
-	for (int i = 0; i < LIVE_ENTITY_LENGTH; i++) {
-       liveEnts[i] = (LiveEnt){0};
-    }
-	
-	liveEnts[0] = createPlayer(0,0, 700, 28, 28);
-	
-	liveEnts[7] = createMonster(7,700, 700, 256, 256);
-	liveEnts[7].update = wizardUpdate;
-	liveEnts[7].imageIndex = 15;
-	liveEnts[7].flippedIndex = 16;
-
-	liveEnts[1] = createItem(1, 16, 64, 1, 0.5);
-	liveEnts[2] = createItem(2, 80, 320, 1, 2);
-	liveEnts[3] = createItem(3, 1104, 64, 2, 1);
-	liveEnts[4] = createItem(4, 1040, 320, 0.5, 1);
-	liveEnts[5] = createItem(5, 528, 128, 0.5, 0.5);
-	liveEnts[6] = createItem(6, 656, 128, 2, 2);
-
-	
-	int levelgrid[GRID_HEIGHT][GRID_WIDTH] = {
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1},
-		{0,0,0,0,0,0,0,0,1,1,1,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}
-	};
-	
-	memcpy(grid, levelgrid, sizeof(levelgrid));
-	
-	StopMusicStream(musicTracks[1]);
-	PlayMusicStream(musicTracks[2]);
-	
-	PlaySound(sounds[2]);
-
-}
-
-void level11()
-{
-	// reset entities
-	for (int i = 0; i < LIVE_ENTITY_LENGTH; i++) {
-       liveEnts[i] = (LiveEnt){0};
-    }
-	
-	liveEnts[0] = createPlayer(0,200, 625, 126, 126);
-	liveEnts[1] = createItem(1, 300, 765, 1, 0.5);
-	liveEnts[2] = createItem(2, 400, 765, 1, 2);
-	liveEnts[3] = createItem(3, 500, 765, 2, 1);
-	liveEnts[4] = createItem(4, 600, 765, 0.5, 1);
-	liveEnts[5] = createItem(5, 700, 765, 0.5, 0.5);
-	liveEnts[6] = createItem(6, 800, 765, 2, 2);
-
-	
-	int levelgrid[GRID_HEIGHT][GRID_WIDTH] = {
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-		{1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}
-	};
-	
-	memcpy(grid, levelgrid, sizeof(levelgrid));
-	
-	StopMusicStream(musicTracks[2]);
-	PlayMusicStream(musicTracks[3]);
-	
-	PlaySound(sounds[2]);
-}
-
-
-
-
-LiveEnt createPlayer(int index, int x, int y, int width, int height)
-{
-	LiveEnt player = {
-		index,true,true,4,0,0,0,x,y,0,0,0,0,0,0, false, width,height,3, playerUpdate, NULL,
-		playerOnXCollision,playerOnYCollision, playerOnTileXCollision, playerOnTileYCollision };
-		
-	return player;
-}
-
-LiveEnt createMonster(int index, int x, int y, int width, int height)
-{
-	LiveEnt mosnter = {
-		index,true,true,13,3,0,0,x,y,0,0,0,0,0,0, false, width,height,12, monsterUpdate, NULL,
-		playerOnXCollision,playerOnYCollision, playerOnTileXCollision, playerOnTileYCollision };
-		
-	return mosnter;
-}
-
-LiveEnt createPlatform(int index, int x, int y, int width, int height)
-{
-	LiveEnt platform = {
-		index,true,true,5,2,0,0,x,y,0,0,0,0,0,0, false, width,height,5, NULL, NULL,
-		playerOnXCollision, playerOnYCollision, playerOnTileXCollision, playerOnTileYCollision };
-		
-	return platform;
-}
-
-LiveEnt createItem(int index, int x, int y, float scaleX, float scaleY)
-{
-	int imageIndex = 0;
-	
-	if (scaleX == 2 && scaleY == 1) imageIndex = 6;
-	else if (scaleX == 0.5 && scaleY == 1) imageIndex = 7;
-	else if (scaleX == 2 && scaleY == 2) imageIndex = 8;
-	else if (scaleX == 0.5 && scaleY == 0.5) imageIndex = 9;
-	else if (scaleX == 1 && scaleY == 2) imageIndex = 10;
-	else if (scaleX == 1 && scaleY == 0.5) imageIndex = 11;
-	
-	LiveEnt item = {
-		index,true,true,imageIndex,1,scaleX,scaleY,x,y,0,0,0,0,0,0, false, TILE_SIZE/2,TILE_SIZE/2,imageIndex, NULL, NULL,
-		runeOnXCollision, runeOnYCollision, playerOnTileXCollision, playerOnTileYCollision };
-		
-	return item;
-}
-
-
-void update()
-{
-	if (initLevel)
-	{
-		selectedRune = NULL;
-		levels[currentLevel]();
-		initLevel = false;
-	}
-	
-	if (currentLevel > 9)
-	{
-		UpdateMusicStream(musicTracks[3]);
-
-	}
-	else if ( currentLevel == 9)
-	{
-		UpdateMusicStream(musicTracks[2]);
-	}
-	else
-	{
-		UpdateMusicStream(musicTracks[1]);
-	}
-	
-	for (int i = 0; i < LIVE_ENTITY_LENGTH; i++)
-	{
-        if (liveEnts[i].initialised)
-		{
-			if (liveEnts[i].update) liveEnts[i].update(&liveEnts[i]);
-		
-			liveEntUpdate(&liveEnts[i]);
-		}
-    }
-}
-
-void render()
-{
-	for (int x = 0; x < GRID_WIDTH; x++)
-	{
-        for (int y = 0; y < GRID_HEIGHT; y++)
-		{
-			int imageIndex = grid[y][x]+1;
-			
-			if (grid[y][x] == 2) imageIndex = 14;
-			
-            DrawTexturePro(
-				textures[imageIndex],
-				(Rectangle){ 0, 0, textures[imageIndex].width, textures[imageIndex].height },
-				(Rectangle){ x*TILE_SIZE,y*TILE_SIZE, TILE_SIZE, TILE_SIZE },
-				(Vector2){ 0, 0 },
-				0.0f,
-				WHITE
-			);
-        }
-    }
-	
-	if (currentLevel == 10)
-	{
-		DrawTexturePro(
-			textures[17],
-			(Rectangle){ 0, 0, textures[17].width, textures[17].height },
-			(Rectangle){ 0, 0, 1216, 832 },
-			(Vector2){ 0, 0 },
-			0.0f,
-			WHITE
-		);
-	}
-	else if (currentLevel == 11)
-	{
-		if (!viewingStory) {
-			DrawTexturePro(
-				textures[18],
-				(Rectangle){ 0, 0, textures[18].width, textures[18].height },
-				(Rectangle){ 0, 0, 1216, 832 },
-				(Vector2){ 0, 0 },
-				0.0f,
-				WHITE
-			);
-			
-			if (IsKeyDown(KEY_ONE))
-			{
-				viewingStory = true;
-				isHard = false;
-			}
-			
-			if (IsKeyDown(KEY_TWO))
-			{
-				viewingStory = true;
-				isHard = true;
-			}
-		}
-		else{
-			DrawTexturePro(
-				textures[19],
-				(Rectangle){ 0, 0, textures[19].width, textures[19].height },
-				(Rectangle){ 0, 0, 1216, 832 },
-				(Vector2){ 0, 0 },
-				0.0f,
-				WHITE
-			);
-			
-			if (IsKeyDown(KEY_ENTER))
-			{
-				currentLevel = 0;
-				initLevel = true;
-				
-				StopMusicStream(musicTracks[3]);
-				PlayMusicStream(musicTracks[1]);
-			}
-		}
-	}
-	
-	
-	for (int i = 0; i < LIVE_ENTITY_LENGTH; i++)
-	{
-        if (liveEnts[i].initialised)
-		{
-			if (liveEnts[i].render) liveEnts[i].render(&liveEnts[i]);
-		
-			liveEntRender(&liveEnts[i]);
-		}
-
-    }
-	
-	switch (currentLevel)
-    {
-        case 0:
-            // Load level 1 resources, setup level 1 objects
-            DrawText("WASD or arrow keys to move\n\n\nE to pick up runes\n\n\nLEFT CLICK to throw runes\n\n\nRIGHT CLICK to use runes\n\n\nR to restart the level\n\n\nH to view Zebolios' rune research", 15, 15, 40, LIGHTGRAY);
-            break;
-		case 1:
-            // Load level 2 resources, setup level 2 objects
-            DrawText("Avoid the red blocks", 15, 15, 40, LIGHTGRAY);
-            break;
-        case 2:
-            // Load level 2 resources, setup level 2 objects
-            DrawText("Throwing runes on objects makes them shrink or grow", 15, 15, 40, LIGHTGRAY);
-            break;
-        case 3:
-            // Load level 3 resources, setup level 3 objects
-            DrawText("Runes have different effects based on their appearance", 15, 15, 40, LIGHTGRAY);
-            break;
-		case 4:
-            // Load level 3 resources, setup level 3 objects
-            DrawText("Be careful of monsters, unless you're bigger than them", 15, 15, 40, LIGHTGRAY);
-            break;
-		case 5:
-            // Load level 3 resources, setup level 3 objects
-            DrawText("", 15, 15, 40, LIGHTGRAY);
-            break;
-		case 10:
-            // Load level 3 resources, setup level 3 objects
-            DrawText("you escaped! thanks for playing!", 230, 15, 40, GRAY);
-            break;
-        default:
-            DrawText("", 10, 10, 20, DARKGRAY);
-            break;
-    }
-	
-	if (currentLevel == 9 && !liveEnts[7].initialised)
-	{
-		int levelgrid[GRID_HEIGHT][GRID_WIDTH] = {
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1},
-		{0,0,0,0,0,0,0,0,1,1,1,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
-		{1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1,1},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-		{1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}
-	};
-	
-		memcpy(grid, levelgrid, sizeof(levelgrid));
-	}
-
-	char buffer[20];
-
-	if (currentLevel < 10)
-	{
-		sprintf(buffer, "level %i", currentLevel+1);
-		DrawText(buffer, 10, 775, 25, LIGHTGRAY);
-		
-		atime += GetFrameTime();
-	}
-	
-	char buffer2[50];
-	
-	if (currentLevel < 11)
-	{
-		sprintf(buffer2, "time : %.2f", atime);
-		DrawText(buffer2, 10, 805, 25, LIGHTGRAY);
-	}
-	
-	if (viewingAnalysis){
-		DrawTexturePro(
-				textures[20],
-				(Rectangle){ 0, 0, textures[20].width, textures[20].height },
-				(Rectangle){ 0, 0, 1216, 832 },
-				(Vector2){ 0, 0 },
-				0.0f,
-				WHITE
-			);
-	}
-	
-}
-
-void quit()
-{
-	return;
-}
\ No newline at end of file
+#include "OSAKA.h"
+#include <string.h>
+#include <math.h>
+#include <stdio.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+#define ENT_PAGE_LENGTH 256		// entities are allocated a page at a time so pointers stay put as the pool grows
+#define BODY_FIELDS_LENGTH 14	// float arrays in Bodies
+
+#define TILE_SIZE 64
+#define GRID_WIDTH 19			// the built in levels, packed levels can be any size
+#define GRID_HEIGHT 13
+#define SCREEN_WIDTH 1216
+#define SCREEN_HEIGHT 832
+#define FRICTION 0.02
+#define GRAVITY 9.8
+#define TERMINAL_VELOCITY 500
+#define SLEEP_VELOCITY 0.05f	// pixels per base tick on both axes that count as at rest
+#define SLEEP_TICKS 30			// ticks at rest before a body is put to sleep
+#define WAKE_MARGIN 1			// how close a moving body has to pass to wake a sleeping one
+#define SLEEPERS_LENGTH 64		// sleeping bodies one sweep can hold on to, more than that are woken straight away
+#define BASE_TICK_RATE 60		// the rate friction and velocities were tuned at
+#define SNAPSHOT_ALIGNMENT 8
+#define REWIND_INTERVAL 15		// ticks between the snapshots rewinding goes back through
+#define REWIND_LENGTH 40		// snapshots kept, ten seconds at the base tick rate
+#define REWIND_SPEED 3			// times faster than it was played that holding Q goes back
+#define BROADPHASE_CELL_SIZE (TILE_SIZE * 2)
+#define LEVELS_LENGTH 12
+#define MUSIC_CROSSFADE 1.5f		// seconds a level's music takes to fade over the last one
+#define ASSET_GROUP_STARTUP 1
+#define LEVEL_PACK_FILE_NAME RESOURCES_PATH "levels.oskl"
+
+#define LENGTH(array) (sizeof(array) / sizeof((array)[0]))
+
+#define ARCHETYPE_PLAYER 0
+#define ARCHETYPE_MONSTER 1
+#define ARCHETYPE_WIZARD 2
+#define ARCHETYPE_PLATFORM 3
+#define ARCHETYPE_RUNE 4
+#define ARCHETYPES_LENGTH 5
+
+// sprite layers, back to front
+#define LAYER_TILES 0
+#define LAYER_SCREEN 1			// the end, menu and story pictures
+#define LAYER_PLATFORMS 2
+#define LAYER_MONSTERS 3
+#define LAYER_RUNES 4
+#define LAYER_PLAYER 5
+#define LAYER_TEXT 6
+#define LAYER_OVERLAY 7			// the rune analysis picture, over the hud
+
+#define HUD_FONT 1				// empty until the game ships a font, the text falls back to raylib's until then
+
+#define SPAWN_FACING_LEFT 1
+
+#define SPAWN_PLAYER(x, y, width, height) { ARCHETYPE_PLAYER, 0, x, y, width, height, 1, 1 }
+#define SPAWN_MONSTER(x, y, width, height, flags) { ARCHETYPE_MONSTER, flags, x, y, width, height, 1, 1 }
+#define SPAWN_WIZARD(x, y, width, height) { ARCHETYPE_WIZARD, 0, x, y, width, height, 1, 1 }
+#define SPAWN_PLATFORM(x, y, width, height) { ARCHETYPE_PLATFORM, 0, x, y, width, height, 1, 1 }
+#define SPAWN_RUNE(x, y, scaleX, scaleY) { ARCHETYPE_RUNE, 0, x, y, TILE_SIZE/2, TILE_SIZE/2, scaleX, scaleY }
+
+typedef unsigned char uchar;
+typedef unsigned short ushort;
+typedef unsigned int uint;
+typedef unsigned long ulong;
+typedef unsigned long long ullong;
+
+typedef struct LiveEnt LiveEnt;
+typedef struct EntHandle EntHandle;
+typedef struct TileQuery TileQuery;
+typedef struct Contact Contact;
+typedef struct Bodies Bodies;
+typedef struct Snapshot Snapshot;
+typedef struct World World;
+
+void initWorld(World* world, bool interactive);
+void freeWorld(World* world);
+bool isKeyDown(World* world, int key);
+bool isMouseButtonPressed(World* world, int button);
+void playSound(World* world, int index);
+void stepWorld(World* world);
+
+bool reserveEnts(World* world, int length);
+EntHandle spawnEnt(World* world, LiveEnt ent, float x, float y, float width, float height);
+void despawnEnt(World* world, LiveEnt* ent);
+LiveEnt* getEnt(World* world, EntHandle handle);
+EntHandle entHandle(LiveEnt* ent);
+void clearEnts(World* world);
+void flushEnts(World* world);
+void unloadEnts(World* world);
+
+void bodyFields(Bodies* bodies, float** fields[BODY_FIELDS_LENGTH]);
+bool reserveBodies(Bodies* bodies, int capacity);
+float impulse(float force);
+void integrateBody(Bodies* bodies, int i, float dt, float friction, float massBias);
+void integrateBodies(Bodies* bodies, int length, float dt, float massBias);
+void unloadBodies(Bodies* bodies);
+
+void copyBytes(void* to, const void* from, size_t size);
+bool saveSnapshot(World* world, Snapshot* snapshot);
+EntHandle restoreHandle(World* world, const LiveEnt* savedEnts, int slots, EntHandle handle);
+bool restoreSnapshot(World* world, const Snapshot* snapshot);
+void freeSnapshot(Snapshot* snapshot);
+bool restoreLevelStart(World* world, int index);
+void saveLevelStart(World* world, int index);
+void pushRewind(World* world);
+void clearRewind(World* world);
+bool rewindWorld(World* world);
+
+void addContact(World* world, float t, int ent, int tileX, int tileY);
+float timeOfImpact(float start, float end, float otherStart, float otherEnd, float delta);
+bool sweepEnt(World* world, LiveEnt* ent, bool vertical, float step);
+void wakeEnt(World* world, LiveEnt* ent);
+bool isAsleep(World* world, LiveEnt* ent);
+void wakeArea(World* world, Rectangle area);
+Rectangle bodyRect(World* world, LiveEnt* ent);
+void settleEnt(World* world, LiveEnt* ent);
+void liveEntUpdate(World* world, LiveEnt* ent);
+void liveEntRender(World* world, LiveEnt* ent);
+void broadphaseSync(World* world, LiveEnt* ent);
+
+void setGrid(World* world, int levelgrid[GRID_HEIGHT][GRID_WIDTH]);
+void openBossExit(World* world);
+Vector2 cameraTarget(World* world, float x, float y);
+void streamTiles(World* world);
+
+TileQuery tileQuery(Tilemap* map, float left, float top, float right, float bottom, float dirX, float dirY, bool rowMajor);
+bool tileQueryNext(TileQuery* query, int* tileX, int* tileY);
+
+void playerSystem(World* world);
+void monsterSystem(World* world);
+void wizardSystem(World* world);
+void renderSystem(World* world, int archetype);
+
+void entOnXCollision(World* world, LiveEnt* ent, LiveEnt* collider);
+void entOnYCollision(World* world, LiveEnt* ent, LiveEnt* collider);
+void touchRune(World* world, LiveEnt* ent, LiveEnt* rune);
+void touchMonster(World* world, LiveEnt* ent, LiveEnt* monster);
+void blockX(World* world, LiveEnt* ent, LiveEnt* collider);
+void blockY(World* world, LiveEnt* ent, LiveEnt* collider);
+
+void playerUpdate(World* world, LiveEnt* ent);
+void jump(World* world, LiveEnt* ent);
+void pickUpRune(World* world, LiveEnt* ent);
+void playerOnXCollision(World* world, LiveEnt* ent, LiveEnt* collider);
+void playerOnYCollision(World* world, LiveEnt* ent, LiveEnt* collider);
+void playerOnTileXCollision(World* world, LiveEnt* ent, int tileX, int tileY);
+void playerOnTileYCollision(World* world, LiveEnt* ent, int tileX, int tileYr);
+
+void runeOnXCollision(World* world, LiveEnt* ent, LiveEnt* collider);
+void runeOnYCollision(World* world, LiveEnt* ent, LiveEnt* collider);
+void runeOnPlayerCollision(World* world, LiveEnt* ent, LiveEnt* collider);
+
+void monsterUpdate(World* world, LiveEnt* ent);
+void monsterOnXCollision(World* world, LiveEnt* ent, LiveEnt* collider);
+void monsterOnYCollision(World* world, LiveEnt* ent, LiveEnt* collider);
+
+void wizardUpdate(World* world, LiveEnt* ent);
+
+void platformOnXCollision(World* world, LiveEnt* ent, LiveEnt* collider);
+void platformOnYCollision(World* world, LiveEnt* ent, LiveEnt* collider);
+
+EntHandle createPlayer(World* world, int x, int y, int width, int height);
+
+EntHandle createMonster(World* world, int x, int y, int width, int height);
+
+EntHandle createWizard(World* world, int x, int y, int width, int height);
+
+EntHandle createPlatform(World* world, int x, int y, int width, int height);
+
+EntHandle createItem(World* world, int x, int y, float scaleX, float scaleY);
+
+bool buildLevel(World* world, int index, Level level);
+void loadLevel(World* world, int index);
+
+extern const Level builtinLevels[LEVELS_LENGTH];
+
+void init();
+void menuUpdate();
+void update();
+void simulate(World* world);
+uint64_t worldHash();
+void render();
+void quit();
+
+void headlessInit();
+void headlessUpdate();
+void headlessJob(void* data);
+void headlessSweep();
+void headlessQuit();
+
+bool parseBenchEnts(char* list);
+uint benchRandomRange(uint range);
+void benchBuild();
+void benchThrowRunes();
+int compareTimes(const void* a, const void* b);
+void benchReport();
+void benchInit();
+void benchUpdate();
+void benchQuit();
+
+float jumpHeight(int tickRate);
+bool checkJumps();
+
+LevelPack levelPack;			// shared by every world, levels only ever read from it
+bool viewingStory;
+bool viewingAnalysis;
+
+// laid out once and redrawn from cache, the hud ones are only reformatted when what they show changes
+Text levelText;
+Text levelNumberText;
+Text timeText;
+Text statsText;
+int shownLevel = -1;
+float shownTime = -1;
+SpriteStats shownStats = { -1, 0, 0, 0 };
+int shownVoices = -1;
+int shownAhead = -1;
+
+// headless ------------------------------------------------------------------------------------------------------------
+
+#define LEVELS_PLAYABLE 11		// every level minus the menu
+
+int headlessLevel = -1;			// -1 cycles through every playable level
+long long headlessTicks = 600;	// ticks before a run is cut off if the level has not ended
+long long headlessRuns = 1;
+long long headlessRunsDone;
+long long headlessRunTicks;
+
+// --worlds, more than one steps the runs side by side on a job pool instead of one after another through the game
+typedef struct HeadlessWorker HeadlessWorker;
+
+int headlessWorlds = 1;				// 0 for one per processor
+HeadlessWorker* headlessWorkers;
+int headlessWorkersLength;
+Mutex* headlessMutex;				// hands out the runs
+long long headlessRunsTaken;
+
+char* profileFileName;			// --profile, a chrome trace of the whole run is written here on quit
+
+// bench ---------------------------------------------------------------------------------------------------------------
+
+#define BENCH_CONFIGS_LENGTH 16
+#define BENCH_WARMUP_TICKS 60		// ticks stepped before timing starts so the world has settled out of its spawn pile
+#define BENCH_THROW_INTERVAL 60		// default ticks between throws of the same rune
+
+int benchEnts[BENCH_CONFIGS_LENGTH] = { 10, 100, 1000 };	// in the default 19x13 room, past a few thousand it is one pile
+int benchEntsLength = 3;
+int benchGridWidth = GRID_WIDTH;	// cells, the world grows with it so big counts can be spread out
+int benchGridHeight = GRID_HEIGHT;
+int benchMix[3] = { 60, 20, 20 };	// monsters, thrown runes and platforms, relative weights
+int benchTiles = 10;				// percent of the cells above the floor that are solid
+long long benchTicks = 300;
+int benchThrow = BENCH_THROW_INTERVAL;	// 0 never throws, so the world comes to rest
+uint benchSeed = 1;
+
+int benchConfig;
+long long benchTick;
+int benchRunes;						// runes to keep in the world, topped up as they are used up
+ullong benchRandom;
+ullong* benchTimes;					// nanoseconds per timed tick
+double benchEntTicks;				// entities alive summed over the timed ticks
+
+// entity --------------------------------------------------------------------------------------------------------------
+
+struct LiveEnt
+{
+	int index;
+	bool initialised;
+	bool facingRight;		// sprites face right, facing left draws them mirrored
+	int type;
+	float scaleX, scaleY;
+	bool onGround;
+	int imageIndex;
+	int archetype;			// which system updates, collides and draws it
+	
+	uint generation;		// bumped on despawn so old handles to the slot stop resolving
+	int aliveIndex;			// position in aliveEnts
+	int archetypeIndex;		// position in archetypeEnts[archetype]
+};
+
+// generation 0 is never handed out so a zeroed handle is always empty
+struct EntHandle
+{
+	int index;
+	uint generation;
+};
+
+// bodies ---------------------------------------------------------------------------------------------------------------
+
+// kinematic state split out of LiveEnt, one array per field indexed by entity slot,
+// so integrating every body streams through a few floats each instead of whole entities
+struct Bodies
+{
+	float* x;
+	float* y;
+	float* prevX;		// position at the start of the tick, for render interpolation
+	float* prevY;
+	float* dx;
+	float* dy;
+	float* ddx;
+	float* ddy;
+	float* fx;
+	float* fy;
+	float* width;
+	float* height;
+	float* lightMass;	// mass used when the computed one drops below 10, 0 for none
+	float* rest;		// ticks spent at rest, asleep from SLEEP_TICKS, which skips integrating and colliding it
+	
+	int capacity;
+};
+
+// something a move along one axis runs into, t is how far along the move it is reached
+struct Contact
+{
+	float t;
+	int ent;			// slot of the entity, -1 for a tile
+	int tileX, tileY;
+};
+
+// world ---------------------------------------------------------------------------------------------------------------
+
+// a whole world copied out flat, with offsets instead of pointers, so it can be put back by copying it in again
+struct Snapshot
+{
+	unsigned char* data;
+	size_t size;
+	size_t capacity;
+};
+
+// everything one running level owns, so any number of them can be stepped side by side, each on its own thread,
+// the level pack they are loaded from is shared and only read
+struct World
+{
+	Tilemap tilemap;			// the level's cells, sourced straight from the level pack and loaded a chunk at a time
+	Bodies bodies;
+	SpatialHash broadphase;		// entities by slot index, kept in step with every move
+	
+	LiveEnt** entPages;
+	int entPagesLength;
+	int entSlotsLength;			// slots handed out from the pages so far
+	
+	int* freeEnts;				// despawned slots waiting to be reused
+	int freeEntsLength, freeEntsCapacity;
+	
+	int* aliveEnts;				// every spawned entity in spawn order, what the tick and render loops walk
+	int aliveEntsLength, aliveEntsCapacity;
+	
+	int* deadEnts;				// despawned this tick, taken out of aliveEnts by flushEnts
+	int deadEntsLength, deadEntsCapacity;
+	
+	int* archetypeEnts[ARCHETYPES_LENGTH];	// alive entities of each archetype, what the systems walk
+	int archetypeEntsLength[ARCHETYPES_LENGTH], archetypeEntsCapacity[ARCHETYPES_LENGTH];
+	
+	Contact* contacts;			// the move being swept, nearest first
+	int contactsLength, contactsCapacity;
+	
+	EntHandle player;
+	EntHandle wizard;
+	EntHandle selectedRune;
+	
+	Level level;				// points into levelPack
+	int levelIndex;				// what the tilemap and entities were built from, -1 for none
+	int currentLevel;
+	bool initLevel;
+	bool isHard;
+	float atime;
+	
+	bool interactive;			// the one on screen, the only one that reads input and makes any sound
+	long long soundPlays[SOUNDS_LENGTH];
+	long long ticks;			// stepped so far, not counting ones spent rewinding
+	
+	Snapshot* levelStarts;		// by level index, each level as it was just after it was first built
+	int levelStartsLength;
+	Snapshot rewind[REWIND_LENGTH];	// a ring from the last level start on, oldest at rewindHead
+	int rewindHead, rewindLength;
+	int rewinding;				// ticks the rewind key has been held
+};
+
+World game;					// the one being played, on screen and at the keys
+
+void initWorld(World* world, bool interactive)
+{
+	memset(world, 0, sizeof(World));
+	
+	world->interactive = interactive;
+	world->levelIndex = -1;
+	OSAKA_InitSpatialHash(&world->broadphase, BROADPHASE_CELL_SIZE);
+}
+
+void freeWorld(World* world)
+{
+	OSAKA_FreeTilemap(&world->tilemap);
+	unloadEnts(world);
+	OSAKA_FreeSpatialHash(&world->broadphase);
+	free(world->contacts);
+	
+	world->contacts = NULL;
+	world->contactsLength = world->contactsCapacity = 0;
+	
+	for (int i = 0; i < world->levelStartsLength; i++)
+	{
+		freeSnapshot(&world->levelStarts[i]);
+	}
+	
+	for (int i = 0; i < REWIND_LENGTH; i++)
+	{
+		freeSnapshot(&world->rewind[i]);
+	}
+	
+	free(world->levelStarts);
+	
+	world->levelStarts = NULL;
+	world->levelStartsLength = 0;
+	world->levelIndex = -1;
+	clearRewind(world);
+}
+
+// input and sound only reach the interactive world, the others play on with nobody at the keys
+bool isKeyDown(World* world, int key)
+{
+	return world->interactive && OSAKA_IsKeyDown(key);
+}
+
+bool isMouseButtonPressed(World* world, int button)
+{
+	return world->interactive && OSAKA_IsMouseButtonPressed(button);
+}
+
+void playSound(World* world, int index)
+{
+	if (index >= 0 && index < SOUNDS_LENGTH) world->soundPlays[index]++;
+	
+	if (world->interactive) OSAKA_PlaySound(index);
+}
+
+// tiles ---------------------------------------------------------------------------------------------------------------
+
+const int tileTextures[] = { 1, 2, 14 };
+
+Camera2D camera = { { 0, 0 }, { 0, 0 }, 0, 1 };
+Rectangle view;				// what the camera sees this frame in world units, set by render
+
+void setGrid(World* world, int levelgrid[GRID_HEIGHT][GRID_WIDTH])
+{
+	for (int y = 0; y < GRID_HEIGHT; y++)
+	{
+		for (int x = 0; x < GRID_WIDTH; x++)
+		{
+			if (OSAKA_GetTile(&world->tilemap, x, y) == levelgrid[y][x]) continue;
+			
+			OSAKA_SetTile(&world->tilemap, x, y, levelgrid[y][x]);
+			wakeArea(world, (Rectangle){ x * TILE_SIZE, y * TILE_SIZE, TILE_SIZE, TILE_SIZE });
+		}
+	}
+}
+
+// top left of a screen sized view centred on a point, kept inside the world so levels no bigger than the screen never scroll
+Vector2 cameraTarget(World* world, float x, float y)
+{
+	float worldWidth = world->tilemap.width * TILE_SIZE;
+	float worldHeight = world->tilemap.height * TILE_SIZE;
+	Vector2 target = { x - SCREEN_WIDTH / 2.0f, y - SCREEN_HEIGHT / 2.0f };
+	
+	if (target.x > worldWidth - SCREEN_WIDTH) target.x = worldWidth - SCREEN_WIDTH;
+	if (target.y > worldHeight - SCREEN_HEIGHT) target.y = worldHeight - SCREEN_HEIGHT;
+	if (target.x < 0) target.x = 0;
+	if (target.y < 0) target.y = 0;
+	
+	return target;
+}
+
+// walks the non-empty cells overlapping a box, nearest first along the direction of movement
+struct TileQuery
+{
+	Tilemap* map;
+	int firstX, lastX, stepX;
+	int firstY, lastY, stepY;
+	bool rowMajor;		// rows in the outer loop, used for vertical movement
+	int x, y;
+	bool done;
+};
+
+TileQuery tileQuery(Tilemap* map, float left, float top, float right, float bottom, float dirX, float dirY, bool rowMajor)
+{
+	TileQuery query = {0};
+	
+	query.map = map;
+	
+	// a cell overlaps when the box reaches strictly inside it
+	int minX = (int)floorf(left / TILE_SIZE);
+	int maxX = (int)ceilf(right / TILE_SIZE) - 1;
+	int minY = (int)floorf(top / TILE_SIZE);
+	int maxY = (int)ceilf(bottom / TILE_SIZE) - 1;
+	
+	if (minX < 0) minX = 0;
+	if (maxX > map->width - 1) maxX = map->width - 1;
+	if (minY < 0) minY = 0;
+	if (maxY > map->height - 1) maxY = map->height - 1;
+	
+	if (minX > maxX || minY > maxY)
+	{
+		query.done = true;
+		return query;
+	}
+	
+	query.stepX = dirX < 0 ? -1 : 1;
+	query.firstX = dirX < 0 ? maxX : minX;
+	query.lastX = dirX < 0 ? minX : maxX;
+	
+	query.stepY = dirY < 0 ? -1 : 1;
+	query.firstY = dirY < 0 ? maxY : minY;
+	query.lastY = dirY < 0 ? minY : maxY;
+	
+	query.rowMajor = rowMajor;
+	query.x = query.firstX;
+	query.y = query.firstY;
+	
+	return query;
+}
+
+bool tileQueryNext(TileQuery* query, int* tileX, int* tileY)
+{
+	while (!query->done)
+	{
+		int x = query->x;
+		int y = query->y;
+		
+		// advance the inner axis, wrapping into the outer one
+		if (query->rowMajor)
+		{
+			if (query->x != query->lastX) query->x += query->stepX;
+			else if (query->y != query->lastY) { query->x = query->firstX; query->y += query->stepY; }
+			else query->done = true;
+		}
+		else
+		{
+			if (query->y != query->lastY) query->y += query->stepY;
+			else if (query->x != query->lastX) { query->y = query->firstY; query->x += query->stepX; }
+			else query->done = true;
+		}
+		
+		if (OSAKA_GetTile(query->map, x, y))
+		{
+			*tileX = x;
+			*tileY = y;
+			return true;
+		}
+	}
+	
+	return false;
+}
+
+
+// pool -----------------------------------------------------------------------------------------------------------------
+
+bool reserveInts(int** array, int* capacity, int length)
+{
+	if (length < *capacity) return true;
+	
+	int grown = *capacity ? *capacity * 2 : 64;
+	int* data = realloc(*array, grown * sizeof(int));
+	
+	if (!data)
+	{
+		TraceLog(LOG_ERROR, "could not grow entity pool, out of memory (length : %i)", length);
+		return false;
+	}
+	
+	*array = data;
+	*capacity = grown;
+	
+	return true;
+}
+
+LiveEnt* entAt(World* world, int index)
+{
+	return &world->entPages[index / ENT_PAGE_LENGTH][index % ENT_PAGE_LENGTH];
+}
+
+// pages and bodies for at least length slots, pages are never moved or given back so entity pointers stay put
+bool reserveEnts(World* world, int length)
+{
+	while (world->entPagesLength * ENT_PAGE_LENGTH < length)
+	{
+		LiveEnt** pages = realloc(world->entPages, (world->entPagesLength + 1) * sizeof(LiveEnt*));
+		
+		if (!pages) return false;
+		
+		world->entPages = pages;
+		
+		LiveEnt* page = calloc(ENT_PAGE_LENGTH, sizeof(LiveEnt));
+		
+		if (!page) return false;
+		
+		if (!reserveBodies(&world->bodies, (world->entPagesLength + 1) * ENT_PAGE_LENGTH))
+		{
+			free(page);
+			return false;
+		}
+		
+		world->entPages[world->entPagesLength++] = page;
+	}
+	
+	return true;
+}
+
+EntHandle spawnEnt(World* world, LiveEnt ent, float x, float y, float width, float height)
+{
+	if (ent.archetype < 0 || ent.archetype >= ARCHETYPES_LENGTH)
+	{
+		TraceLog(LOG_ERROR, "could not spawn entity, unknown archetype (archetype : %i)", ent.archetype);
+		return (EntHandle){0};
+	}
+	
+	if (!reserveInts(&world->aliveEnts, &world->aliveEntsCapacity, world->aliveEntsLength)) return (EntHandle){0};
+	if (!reserveInts(&world->archetypeEnts[ent.archetype], &world->archetypeEntsCapacity[ent.archetype], world->archetypeEntsLength[ent.archetype])) return (EntHandle){0};
+	
+	int index;
+	
+	if (world->freeEntsLength)
+	{
+		index = world->freeEnts[--world->freeEntsLength];
+	}
+	else
+	{
+		if (!reserveEnts(world, world->entSlotsLength + 1))
+		{
+			TraceLog(LOG_ERROR, "could not spawn entity, out of memory (entities : %i)", world->entSlotsLength);
+			return (EntHandle){0};
+		}
+		
+		index = world->entSlotsLength++;
+	}
+	
+	LiveEnt* slot = entAt(world, index);
+	uint generation = slot->generation ? slot->generation : 1;
+	
+	*slot = ent;
+	slot->index = index;
+	slot->initialised = true;
+	slot->generation = generation;
+	slot->aliveIndex = world->aliveEntsLength;
+	slot->archetypeIndex = world->archetypeEntsLength[ent.archetype];
+	
+	world->bodies.x[index] = world->bodies.prevX[index] = x;
+	world->bodies.y[index] = world->bodies.prevY[index] = y;
+	world->bodies.dx[index] = world->bodies.dy[index] = 0;
+	world->bodies.ddx[index] = world->bodies.ddy[index] = 0;
+	world->bodies.fx[index] = world->bodies.fy[index] = 0;
+	world->bodies.width[index] = width;
+	world->bodies.height[index] = height;
+	world->bodies.lightMass[index] = ent.type == 0 ? 15 : 0;
+	world->bodies.rest[index] = 0;
+	
+	world->aliveEnts[world->aliveEntsLength++] = index;
+	world->archetypeEnts[ent.archetype][world->archetypeEntsLength[ent.archetype]++] = index;
+	
+	return (EntHandle){ index, generation };
+}
+
+void despawnEnt(World* world, LiveEnt* ent)
+{
+	if (!ent->initialised) return;
+	
+	// stays in aliveEnts until the end of the tick so loops over it are not reshuffled mid walk
+	if (!reserveInts(&world->deadEnts, &world->deadEntsCapacity, world->deadEntsLength)) return;
+	
+	// whatever rested on or against it has nothing holding it up any more
+	wakeArea(world, bodyRect(world, ent));
+	
+	ent->initialised = false;
+	if (!++ent->generation) ent->generation = 1;
+	
+	world->deadEnts[world->deadEntsLength++] = ent->index;
+}
+
+LiveEnt* getEnt(World* world, EntHandle handle)
+{
+	if (!handle.generation || handle.index < 0 || handle.index >= world->entSlotsLength) return NULL;
+	
+	LiveEnt* ent = entAt(world, handle.index);
+	
+	return (ent->initialised && ent->generation == handle.generation) ? ent : NULL;
+}
+
+EntHandle entHandle(LiveEnt* ent)
+{
+	return (EntHandle){ ent->index, ent->generation };
+}
+
+void flushEnts(World* world)
+{
+	for (int i = 0; i < world->deadEntsLength; i++)
+	{
+		LiveEnt* ent = entAt(world, world->deadEnts[i]);
+		int last = world->aliveEnts[--world->aliveEntsLength];
+		
+		world->aliveEnts[ent->aliveIndex] = last;
+		entAt(world, last)->aliveIndex = ent->aliveIndex;
+		
+		int* archetype = world->archetypeEnts[ent->archetype];
+		last = archetype[--world->archetypeEntsLength[ent->archetype]];
+		
+		archetype[ent->archetypeIndex] = last;
+		entAt(world, last)->archetypeIndex = ent->archetypeIndex;
+		
+		if (reserveInts(&world->freeEnts, &world->freeEntsCapacity, world->freeEntsLength)) world->freeEnts[world->freeEntsLength++] = ent->index;
+		
+		OSAKA_RemoveFromSpatialHash(&world->broadphase, ent->index);
+	}
+	
+	world->deadEntsLength = 0;
+}
+
+void clearEnts(World* world)
+{
+	for (int i = 0; i < world->aliveEntsLength; i++)
+	{
+		LiveEnt* ent = entAt(world, world->aliveEnts[i]);
+		
+		ent->initialised = false;
+		if (!++ent->generation) ent->generation = 1;
+	}
+	
+	// hand slots out from the start again so a level always gets the same ones
+	world->aliveEntsLength = 0;
+	world->deadEntsLength = 0;
+	world->freeEntsLength = 0;
+	world->entSlotsLength = 0;
+	
+	for (int i = 0; i < ARCHETYPES_LENGTH; i++)
+	{
+		world->archetypeEntsLength[i] = 0;
+	}
+	
+	OSAKA_ClearSpatialHash(&world->broadphase);
+}
+
+void unloadEnts(World* world)
+{
+	for (int i = 0; i < world->entPagesLength; i++)
+	{
+		free(world->entPages[i]);
+	}
+	
+	free(world->entPages);
+	free(world->freeEnts);
+	free(world->aliveEnts);
+	free(world->deadEnts);
+	
+	for (int i = 0; i < ARCHETYPES_LENGTH; i++)
+	{
+		free(world->archetypeEnts[i]);
+		
+		world->archetypeEnts[i] = NULL;
+		world->archetypeEntsLength[i] = world->archetypeEntsCapacity[i] = 0;
+	}
+	
+	unloadBodies(&world->bodies);
+	
+	world->entPages = NULL;
+	world->freeEnts = world->aliveEnts = world->deadEnts = NULL;
+	world->entPagesLength = world->entSlotsLength = 0;
+	world->freeEntsLength = world->freeEntsCapacity = 0;
+	world->aliveEntsLength = world->aliveEntsCapacity = 0;
+	world->deadEntsLength = world->deadEntsCapacity = 0;
+}
+
+void bodyFields(Bodies* bodies, float** fields[BODY_FIELDS_LENGTH])
+{
+	float** all[BODY_FIELDS_LENGTH] = {
+		&bodies->x, &bodies->y, &bodies->prevX, &bodies->prevY, &bodies->dx, &bodies->dy, &bodies->ddx, &bodies->ddy,
+		&bodies->fx, &bodies->fy, &bodies->width, &bodies->height, &bodies->lightMass, &bodies->rest };
+	
+	memcpy(fields, all, sizeof(all));
+}
+
+bool reserveBodies(Bodies* bodies, int capacity)
+{
+	if (capacity <= bodies->capacity) return true;
+	
+	float** fields[BODY_FIELDS_LENGTH];
+	
+	bodyFields(bodies, fields);
+	
+	for (int i = 0; i < BODY_FIELDS_LENGTH; i++)
+	{
+		float* data = realloc(*fields[i], capacity * sizeof(float));
+		
+		if (!data)
+		{
+			TraceLog(LOG_ERROR, "could not grow bodies, out of memory (capacity : %i)", capacity);
+			return false;
+		}
+		
+		memset(data + bodies->capacity, 0, (capacity - bodies->capacity) * sizeof(float));
+		*fields[i] = data;
+	}
+	
+	bodies->capacity = capacity;
+	
+	return true;
+}
+
+void unloadBodies(Bodies* bodies)
+{
+	free(bodies->x);
+	free(bodies->y);
+	free(bodies->prevX);
+	free(bodies->prevY);
+	free(bodies->dx);
+	free(bodies->dy);
+	free(bodies->ddx);
+	free(bodies->ddy);
+	free(bodies->fx);
+	free(bodies->fy);
+	free(bodies->width);
+	free(bodies->height);
+	free(bodies->lightMass);
+	free(bodies->rest);
+	
+	*bodies = (Bodies){0};
+}
+
+// a force that only lasts one tick (a jump, a throw) gives velocity by the tick's length, so it is scaled up as
+// ticks get shorter to give the same kick it gave at the base tick rate
+float impulse(float force)
+{
+	return force * OSAKA_GetTickRate() / BASE_TICK_RATE;
+}
+
+// one body of integrateBodies, also the tail and the fallback when there is no SSE
+void integrateBody(Bodies* bodies, int i, float dt, float friction, float massBias)
+{
+	bodies->prevX[i] = bodies->x[i];
+	bodies->prevY[i] = bodies->y[i];
+	
+	// anything pushing it wakes it up
+	if (bodies->fx[i] != 0 || bodies->fy[i] != 0) bodies->rest[i] = 0;
+	
+	if (bodies->rest[i] >= SLEEP_TICKS) return;
+	
+	// Apply friction
+	bodies->dx[i] *= friction;
+	bodies->dy[i] *= friction;
+	
+	// Update acceleration based on force and mass, mass is truncated like the uint it used to be
+	float mass = (float)(int)((bodies->width[i] + bodies->height[i] + massBias) / 7);
+	
+	if (mass < 10 && bodies->lightMass[i] > 0) mass = bodies->lightMass[i];
+	if (mass < 1) mass = 1;		// shrunk to nothing, would divide by zero
+	
+	bodies->ddx[i] = bodies->fx[i] / mass;
+	bodies->ddy[i] = bodies->fy[i] / mass;
+	
+	// Apply acceleration to velocity
+	bodies->dx[i] += bodies->ddx[i] * dt;
+	bodies->dy[i] += (bodies->ddy[i] + (float)GRAVITY) * dt;
+	
+	// Apply terminal velocity to prevent infinite falling speed
+	if (bodies->dy[i] > TERMINAL_VELOCITY) bodies->dy[i] = TERMINAL_VELOCITY;
+}
+
+// friction, forces, gravity and terminal velocity for every slot below length, dead and sleeping slots included
+// since it is cheaper to integrate them and keep the old values than to skip them
+void integrateBodies(Bodies* bodies, int length, float dt, float massBias)
+{
+	float friction = powf(1 - FRICTION, dt * BASE_TICK_RATE);
+	int i = 0;
+	
+#if defined(__SSE2__) || defined(_M_X64)
+	__m128 vFriction = _mm_set1_ps(friction);
+	__m128 vDt = _mm_set1_ps(dt);
+	__m128 vMassBias = _mm_set1_ps(massBias);
+	__m128 vSeven = _mm_set1_ps(7);
+	__m128 vTen = _mm_set1_ps(10);
+	__m128 vOne = _mm_set1_ps(1);
+	__m128 vZero = _mm_setzero_ps();
+	__m128 vGravity = _mm_set1_ps((float)GRAVITY);
+	__m128 vTerminal = _mm_set1_ps(TERMINAL_VELOCITY);
+	__m128 vSleepTicks = _mm_set1_ps(SLEEP_TICKS);
+	
+	for (; i + 4 <= length; i += 4)
+	{
+		_mm_storeu_ps(bodies->prevX + i, _mm_loadu_ps(bodies->x + i));
+		_mm_storeu_ps(bodies->prevY + i, _mm_loadu_ps(bodies->y + i));
+		
+		__m128 fx = _mm_loadu_ps(bodies->fx + i);
+		__m128 fy = _mm_loadu_ps(bodies->fy + i);
+		__m128 rest = _mm_andnot_ps(_mm_or_ps(_mm_cmpneq_ps(fx, vZero), _mm_cmpneq_ps(fy, vZero)), _mm_loadu_ps(bodies->rest + i));
+		__m128 awake = _mm_cmplt_ps(rest, vSleepTicks);
+		
+		__m128 oldDx = _mm_loadu_ps(bodies->dx + i);
+		__m128 oldDy = _mm_loadu_ps(bodies->dy + i);
+		__m128 dx = _mm_mul_ps(oldDx, vFriction);
+		__m128 dy = _mm_mul_ps(oldDy, vFriction);
+		
+		__m128 size = _mm_add_ps(_mm_add_ps(_mm_loadu_ps(bodies->width + i), _mm_loadu_ps(bodies->height + i)), vMassBias);
+		__m128 mass = _mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_div_ps(size, vSeven)));
+		
+		__m128 lightMass = _mm_loadu_ps(bodies->lightMass + i);
+		__m128 useLight = _mm_and_ps(_mm_cmplt_ps(mass, vTen), _mm_cmpgt_ps(lightMass, vZero));
+		mass = _mm_or_ps(_mm_and_ps(useLight, lightMass), _mm_andnot_ps(useLight, mass));
+		mass = _mm_max_ps(mass, vOne);
+		
+		__m128 ddx = _mm_div_ps(fx, mass);
+		__m128 ddy = _mm_div_ps(fy, mass);
+		
+		dx = _mm_add_ps(dx, _mm_mul_ps(ddx, vDt));
+		dy = _mm_add_ps(dy, _mm_mul_ps(_mm_add_ps(ddy, vGravity), vDt));
+		dy = _mm_min_ps(dy, vTerminal);
+		
+		// sleeping lanes keep what they had
+		dx = _mm_or_ps(_mm_and_ps(awake, dx), _mm_andnot_ps(awake, oldDx));
+		dy = _mm_or_ps(_mm_and_ps(awake, dy), _mm_andnot_ps(awake, oldDy));
+		ddx = _mm_or_ps(_mm_and_ps(awake, ddx), _mm_andnot_ps(awake, _mm_loadu_ps(bodies->ddx + i)));
+		ddy = _mm_or_ps(_mm_and_ps(awake, ddy), _mm_andnot_ps(awake, _mm_loadu_ps(bodies->ddy + i)));
+		
+		_mm_storeu_ps(bodies->rest + i, rest);
+		_mm_storeu_ps(bodies->ddx + i, ddx);
+		_mm_storeu_ps(bodies->ddy + i, ddy);
+		_mm_storeu_ps(bodies->dx + i, dx);
+		_mm_storeu_ps(bodies->dy + i, dy);
+	}
+#endif
+	
+	for (; i < length; i++)
+	{
+		integrateBody(bodies, i, dt, friction, massBias);
+	}
+}
+
+// snapshots -----------------------------------------------------------------------------------------------------------
+
+// where each array of a snapshot starts, as offsets from the start of its data so the buffer holds no pointers
+typedef struct SnapshotHeader
+{
+	int levelIndex;
+	int currentLevel;
+	bool initLevel;
+	EntHandle player;
+	EntHandle wizard;
+	EntHandle selectedRune;
+	
+	int entSlotsLength;
+	int freeEntsLength;
+	int aliveEntsLength;
+	int deadEntsLength;
+	int archetypeEntsLength[ARCHETYPES_LENGTH];
+	int editsLength;
+	
+	size_t ents;			// entSlotsLength LiveEnts
+	size_t bodies;			// BODY_FIELDS_LENGTH arrays of entSlotsLength floats, one after another
+	size_t freeEnts;
+	size_t aliveEnts;
+	size_t deadEnts;
+	size_t archetypeEnts[ARCHETYPES_LENGTH];
+	size_t edits;			// editsLength TilemapEdits
+} SnapshotHeader;
+
+// hands out the next bytes of a snapshot, each section aligned so it can be read in place
+size_t snapshotSection(size_t* size, size_t bytes)
+{
+	size_t offset = *size;
+	
+	*size += (bytes + SNAPSHOT_ALIGNMENT - 1) / SNAPSHOT_ALIGNMENT * SNAPSHOT_ALIGNMENT;
+	
+	return offset;
+}
+
+// lists that never had anything in them are still NULL, and memcpy wants real pointers even for nothing
+void copyBytes(void* to, const void* from, size_t size)
+{
+	if (size) memcpy(to, from, size);
+}
+
+bool saveSnapshot(World* world, Snapshot* snapshot)
+{
+	SnapshotHeader header = {0};
+	int slots = world->entSlotsLength;
+	size_t size = 0;
+	
+	header.levelIndex = world->levelIndex;
+	header.currentLevel = world->currentLevel;
+	header.initLevel = world->initLevel;
+	header.player = world->player;
+	header.wizard = world->wizard;
+	header.selectedRune = world->selectedRune;
+	header.entSlotsLength = slots;
+	header.freeEntsLength = world->freeEntsLength;
+	header.aliveEntsLength = world->aliveEntsLength;
+	header.deadEntsLength = world->deadEntsLength;
+	header.editsLength = OSAKA_SaveTilemapEdits(&world->tilemap, NULL);
+	
+	snapshotSection(&size, sizeof(SnapshotHeader));
+	header.ents = snapshotSection(&size, slots * sizeof(LiveEnt));
+	header.bodies = snapshotSection(&size, BODY_FIELDS_LENGTH * slots * sizeof(float));
+	header.freeEnts = snapshotSection(&size, header.freeEntsLength * sizeof(int));
+	header.aliveEnts = snapshotSection(&size, header.aliveEntsLength * sizeof(int));
+	header.deadEnts = snapshotSection(&size, header.deadEntsLength * sizeof(int));
+	
+	for (int i = 0; i < ARCHETYPES_LENGTH; i++)
+	{
+		header.archetypeEntsLength[i] = world->archetypeEntsLength[i];
+		header.archetypeEnts[i] = snapshotSection(&size, header.archetypeEntsLength[i] * sizeof(int));
+	}
+	
+	header.edits = snapshotSection(&size, header.editsLength * sizeof(TilemapEdit));
+	
+	// the buffer is kept between saves so taking one every few ticks settles into never allocating
+	if (size > snapshot->capacity)
+	{
+		unsigned char* data = realloc(snapshot->data, size);
+		
+		if (!data)
+		{
+			TraceLog(LOG_ERROR, "could not save snapshot, out of memory (size : %zu)", size);
+			return false;
+		}
+		
+		snapshot->data = data;
+		snapshot->capacity = size;
+	}
+	
+	unsigned char* data = snapshot->data;
+	float** fields[BODY_FIELDS_LENGTH];
+	
+	memcpy(data, &header, sizeof(SnapshotHeader));
+	
+	for (int page = 0; page * ENT_PAGE_LENGTH < slots; page++)
+	{
+		int length = slots - page * ENT_PAGE_LENGTH < ENT_PAGE_LENGTH ? slots - page * ENT_PAGE_LENGTH : ENT_PAGE_LENGTH;
+		
+		memcpy(data + header.ents + page * ENT_PAGE_LENGTH * sizeof(LiveEnt), world->entPages[page], length * sizeof(LiveEnt));
+	}
+	
+	bodyFields(&world->bodies, fields);
+	
+	for (int i = 0; i < BODY_FIELDS_LENGTH; i++)
+	{
+		copyBytes(data + header.bodies + i * slots * sizeof(float), *fields[i], slots * sizeof(float));
+	}
+	
+	copyBytes(data + header.freeEnts, world->freeEnts, header.freeEntsLength * sizeof(int));
+	copyBytes(data + header.aliveEnts, world->aliveEnts, header.aliveEntsLength * sizeof(int));
+	copyBytes(data + header.deadEnts, world->deadEnts, header.deadEntsLength * sizeof(int));
+	
+	for (int i = 0; i < ARCHETYPES_LENGTH; i++)
+	{
+		copyBytes(data + header.archetypeEnts[i], world->archetypeEnts[i], header.archetypeEntsLength[i] * sizeof(int));
+	}
+	
+	OSAKA_SaveTilemapEdits(&world->tilemap, (TilemapEdit*)(data + header.edits));
+	
+	snapshot->size = size;
+	
+	return true;
+}
+
+// grows an int list to hold at least length, unlike reserveInts which only makes room for one more
+bool reserveIntsLength(int** array, int* capacity, int length)
+{
+	while (*capacity < length)
+	{
+		if (!reserveInts(array, capacity, *capacity)) return false;
+	}
+	
+	return true;
+}
+
+// a handle saved with a snapshot, moved on to the generation its entity was put back with, empty if it was already stale
+EntHandle restoreHandle(World* world, const LiveEnt* savedEnts, int slots, EntHandle handle)
+{
+	if (!handle.generation || handle.index < 0 || handle.index >= slots) return (EntHandle){0};
+	
+	const LiveEnt* saved = &savedEnts[handle.index];
+	
+	if (!saved->initialised || saved->generation != handle.generation) return (EntHandle){0};
+	
+	return entHandle(entAt(world, handle.index));
+}
+
+// puts the world back as it was saved, a copy per array sized by the entities it held rather than the
+// level, the tilemap only has its changed chunks put back since the rest is still in the level pack
+bool restoreSnapshot(World* world, const Snapshot* snapshot)
+{
+	SnapshotHeader header;
+	
+	if (!snapshot->size) return false;
+	
+	memcpy(&header, snapshot->data, sizeof(SnapshotHeader));
+	
+	int slots = header.entSlotsLength;
+	
+	// everything that can fail is done before anything is changed, so a failed restore leaves the world running as it was
+	if (!reserveEnts(world, slots)) return false;
+	if (!reserveIntsLength(&world->freeEnts, &world->freeEntsCapacity, header.freeEntsLength)) return false;
+	if (!reserveIntsLength(&world->aliveEnts, &world->aliveEntsCapacity, header.aliveEntsLength)) return false;
+	if (!reserveIntsLength(&world->deadEnts, &world->deadEntsCapacity, header.deadEntsLength)) return false;
+	
+	for (int i = 0; i < ARCHETYPES_LENGTH; i++)
+	{
+		if (!reserveIntsLength(&world->archetypeEnts[i], &world->archetypeEntsCapacity[i], header.archetypeEntsLength[i])) return false;
+	}
+	
+	const unsigned char* data = snapshot->data;
+	const LiveEnt* savedEnts = (const LiveEnt*)(data + header.ents);
+	
+	// a snapshot of another level gets its tilemap built on the side and only swapped in once the edits are on it
+	Level level = world->level;
+	Tilemap levelTilemap;
+	Tilemap* tilemap = &world->tilemap;
+	
+	if (header.levelIndex != world->levelIndex)
+	{
+		if (header.levelIndex < 0 || !OSAKA_GetLevel(&levelPack, header.levelIndex, &level))
+		{
+			TraceLog(LOG_ERROR, "could not restore snapshot, level not in the pack (level : %i)", header.levelIndex);
+			return false;
+		}
+		
+		if (!OSAKA_InitTilemap(&levelTilemap, level.gridWidth, level.gridHeight, TILE_SIZE, level.tiles)) return false;
+		
+		tilemap = &levelTilemap;
+	}
+	
+	if (!OSAKA_LoadTilemapEdits(tilemap, (const TilemapEdit*)(data + header.edits), header.editsLength))
+	{
+		if (tilemap != &world->tilemap) OSAKA_FreeTilemap(tilemap);
+		
+		return false;
+	}
+	
+	// nothing can fail from here on
+	if (tilemap != &world->tilemap)
+	{
+		OSAKA_FreeTilemap(&world->tilemap);
+		
+		world->tilemap = levelTilemap;
+		world->level = level;
+		world->levelIndex = header.levelIndex;
+	}
+	
+	// everything alive now is done with as if the level had been cleared, and generations only ever go forward,
+	// so no handle taken since the snapshot can resolve to what it puts back
+	for (int i = 0; i < world->aliveEntsLength; i++)
+	{
+		LiveEnt* ent = entAt(world, world->aliveEnts[i]);
+		
+		ent->initialised = false;
+		if (!++ent->generation) ent->generation = 1;
+	}
+	
+	for (int i = 0; i < slots; i++)
+	{
+		LiveEnt* ent = entAt(world, i);
+		uint generation = ent->generation;
+		
+		*ent = savedEnts[i];
+		ent->generation = (ent->initialised && !generation) ? 1 : generation;
+	}
+	
+	float** fields[BODY_FIELDS_LENGTH];
+	
+	bodyFields(&world->bodies, fields);
+	
+	for (int i = 0; i < BODY_FIELDS_LENGTH; i++)
+	{
+		copyBytes(*fields[i], data + header.bodies + i * slots * sizeof(float), slots * sizeof(float));
+	}
+	
+	copyBytes(world->freeEnts, data + header.freeEnts, header.freeEntsLength * sizeof(int));
+	copyBytes(world->aliveEnts, data + header.aliveEnts, header.aliveEntsLength * sizeof(int));
+	copyBytes(world->deadEnts, data + header.deadEnts, header.deadEntsLength * sizeof(int));
+	
+	for (int i = 0; i < ARCHETYPES_LENGTH; i++)
+	{
+		copyBytes(world->archetypeEnts[i], data + header.archetypeEnts[i], header.archetypeEntsLength[i] * sizeof(int));
+		world->archetypeEntsLength[i] = header.archetypeEntsLength[i];
+	}
+	
+	world->entSlotsLength = slots;
+	world->freeEntsLength = header.freeEntsLength;
+	world->aliveEntsLength = header.aliveEntsLength;
+	world->deadEntsLength = header.deadEntsLength;
+	world->currentLevel = header.currentLevel;
+	world->initLevel = header.initLevel;
+	world->player = restoreHandle(world, savedEnts, slots, header.player);
+	world->wizard = restoreHandle(world, savedEnts, slots, header.wizard);
+	world->selectedRune = restoreHandle(world, savedEnts, slots, header.selectedRune);
+	world->contactsLength = 0;
+	
+	// the broadphase is rebuilt rather than kept, it is only ever a function of the bodies
+	OSAKA_ClearSpatialHash(&world->broadphase);
+	
+	for (int i = 0; i < world->aliveEntsLength; i++)
+	{
+		broadphaseSync(world, entAt(world, world->aliveEnts[i]));
+	}
+	
+	return true;
+}
+
+// starting a level over copies it back out of the snapshot taken when it was first built
+bool restoreLevelStart(World* world, int index)
+{
+	if (index < 0 || index >= world->levelStartsLength) return false;
+	
+	return restoreSnapshot(world, &world->levelStarts[index]);
+}
+
+void saveLevelStart(World* world, int index)
+{
+	if (index >= world->levelStartsLength)
+	{
+		Snapshot* starts = realloc(world->levelStarts, (index + 1) * sizeof(Snapshot));
+		
+		if (!starts)
+		{
+			TraceLog(LOG_WARNING, "could not keep level start, out of memory (level : %i)", index);
+			return;
+		}
+		
+		memset(starts + world->levelStartsLength, 0, (index + 1 - world->levelStartsLength) * sizeof(Snapshot));
+		
+		world->levelStarts = starts;
+		world->levelStartsLength = index + 1;
+	}
+	
+	saveSnapshot(world, &world->levelStarts[index]);
+}
+
+// the oldest snapshot in the ring is overwritten once it is full
+void pushRewind(World* world)
+{
+	int slot = (world->rewindHead + world->rewindLength) % REWIND_LENGTH;
+	
+	if (!saveSnapshot(world, &world->rewind[slot])) return;
+	
+	if (world->rewindLength < REWIND_LENGTH) world->rewindLength++;
+	else world->rewindHead = (world->rewindHead + 1) % REWIND_LENGTH;
+}
+
+void clearRewind(World* world)
+{
+	world->rewindHead = 0;
+	world->rewindLength = 0;
+	world->rewinding = 0;
+}
+
+// goes back a snapshot every few ticks while held, the oldest is kept to sit on for as long as it is held
+bool rewindWorld(World* world)
+{
+	if (!world->rewindLength) return false;
+	
+	if (world->rewinding++ % (REWIND_INTERVAL / REWIND_SPEED)) return true;
+	
+	if (!restoreSnapshot(world, &world->rewind[(world->rewindHead + world->rewindLength - 1) % REWIND_LENGTH])) return false;
+	
+	if (world->rewindLength > 1) world->rewindLength--;
+	
+	return true;
+}
+
+void freeSnapshot(Snapshot* snapshot)
+{
+	free(snapshot->data);
+	
+	*snapshot = (Snapshot){0};
+}
+
+// entity --------------------------------------------------------------------------------------------------------------
+
+void addContact(World* world, float t, int ent, int tileX, int tileY)
+{
+	if (world->contactsLength == world->contactsCapacity)
+	{
+		int capacity = world->contactsCapacity ? world->contactsCapacity * 2 : 64;
+		Contact* grown = realloc(world->contacts, capacity * sizeof(Contact));
+		
+		if (!grown)
+		{
+			TraceLog(LOG_ERROR, "could not grow contacts, out of memory, contact dropped (capacity : %i)", world->contactsCapacity);
+			return;
+		}
+		
+		world->contacts = grown;
+		world->contactsCapacity = capacity;
+	}
+	
+	// stays in the order they were found when they tie, entities and then tiles nearest first, like before
+	int i = world->contactsLength++;
+	
+	for (; i > 0 && world->contacts[i - 1].t > t; i--)
+	{
+		world->contacts[i] = world->contacts[i - 1];
+	}
+	
+	world->contacts[i] = (Contact){ t, ent, tileX, tileY };
+}
+
+// how far along a move of delta the span start, end first overlaps other, -1 when it does not in this move,
+// spans already overlapping are reached straight away and ones behind the move never are
+float timeOfImpact(float start, float end, float otherStart, float otherEnd, float delta)
+{
+	if (end > otherStart && otherEnd > start) return 0;
+	
+	if (delta > 0 && otherStart >= end && otherStart - end < delta) return (otherStart - end) / delta;
+	if (delta < 0 && otherEnd <= start && start - otherEnd < -delta) return (start - otherEnd) / -delta;
+	
+	return -1;
+}
+
+// moves the entity along one axis and runs the handler for everything the move reaches, in the order it
+// reaches them, until one of them stops it, so nothing is skipped however far it moves in a tick,
+// returns false if it was killed along the way
+bool sweepEnt(World* world, LiveEnt* ent, bool vertical, float step)
+{
+	int index = ent->index;
+	float* position = vertical ? world->bodies.y : world->bodies.x;
+	float* size = vertical ? world->bodies.height : world->bodies.width;
+	float* velocity = vertical ? world->bodies.dy : world->bodies.dx;
+	float* across = vertical ? world->bodies.x : world->bodies.y;
+	float* acrossSize = vertical ? world->bodies.width : world->bodies.height;
+	
+	float delta = velocity[index] * step;
+	float start = position[index];
+	float end = start + size[index];
+	float acrossStart = across[index];
+	float acrossEnd = acrossStart + acrossSize[index];
+	
+	// everything the box passes over on the way
+	Rectangle swept = vertical ?
+		(Rectangle){ acrossStart, fminf(start, start + delta), acrossSize[index], size[index] + fabsf(delta) } :
+		(Rectangle){ fminf(start, start + delta), acrossStart, size[index] + fabsf(delta), acrossSize[index] };
+	
+	world->contactsLength = 0;
+	
+	// a little wider so whatever it is resting against or carrying is found too
+	int* candidates;
+	int candidatesLength = OSAKA_QuerySpatialHash(&world->broadphase,
+		(Rectangle){ swept.x - WAKE_MARGIN, swept.y - WAKE_MARGIN, swept.width + WAKE_MARGIN * 2, swept.height + WAKE_MARGIN * 2 }, &candidates);
+	int sleepers[SLEEPERS_LENGTH];
+	int sleepersLength = 0;
+	
+	for (int i = 0; i < candidatesLength; i++)
+	{
+		LiveEnt* collider = entAt(world, candidates[i]);
+		int other = collider->index;
+		
+		if (collider == ent || !collider->initialised) continue;
+		
+		if (isAsleep(world, collider))
+		{
+			if (sleepersLength < SLEEPERS_LENGTH) sleepers[sleepersLength++] = other;
+			else wakeEnt(world, collider);
+		}
+		
+		// sliding along something, like walking over a platform, is not running into it
+		if (acrossEnd <= across[other] || across[other] + acrossSize[other] <= acrossStart) continue;
+		
+		float t = timeOfImpact(start, end, position[other], position[other] + size[other], delta);
+		
+		if (t >= 0) addContact(world, t, candidates[i], 0, 0);
+	}
+	
+	TileQuery query = tileQuery(&world->tilemap, swept.x, swept.y, swept.x + swept.width, swept.y + swept.height,
+		vertical ? 0 : delta, vertical ? delta : 0, vertical);
+	int tileX, tileY;
+	
+	while (tileQueryNext(&query, &tileX, &tileY))
+	{
+		float tileAcross = (vertical ? tileX : tileY) * TILE_SIZE;
+		float tileStart = (vertical ? tileY : tileX) * TILE_SIZE;
+		
+		if (acrossEnd <= tileAcross || tileAcross + TILE_SIZE <= acrossStart) continue;
+		
+		float t = timeOfImpact(start, end, tileStart, tileStart + TILE_SIZE, delta);
+		
+		if (t >= 0) addContact(world, t, -1, tileX, tileY);
+	}
+	
+	position[index] = start + delta;
+	
+	// anything reached at the same time as what stopped it still counts
+	float stoppedAt = 2;
+	
+	for (int i = 0; i < world->contactsLength && world->contacts[i].t <= stoppedAt; i++)
+	{
+		Contact contact = world->contacts[i];
+		
+		if (contact.ent >= 0)
+		{
+			LiveEnt* collider = entAt(world, contact.ent);
+			
+			if (!collider->initialised) continue;	// gone to an earlier contact
+			
+			if (vertical) entOnYCollision(world, ent, collider);
+			else entOnXCollision(world, ent, collider);
+		}
+		else
+		{
+			if (vertical) playerOnTileYCollision(world, ent, contact.tileX, contact.tileY);
+			else playerOnTileXCollision(world, ent, contact.tileX, contact.tileY);
+		}
+		
+		if (!ent->initialised) return false;
+		
+		if (stoppedAt > 1 && delta != 0 && velocity[index] == 0) stoppedAt = contact.t;
+	}
+	
+	// only a body that actually got somewhere wakes what it passed, rested against or carried, a pile holding
+	// itself up pushes into its neighbours every tick without going anywhere and would never get to sleep
+	if (position[index] != start)
+	{
+		for (int i = 0; i < sleepersLength; i++)
+		{
+			world->bodies.rest[sleepers[i]] = 0;
+		}
+	}
+	
+	return true;
+}
+
+// only what is moved by being pushed ever rests long enough, the rest are driven every tick
+const bool archetypeSleeps[ARCHETYPES_LENGTH] = { false, false, false, true, true };
+
+void wakeEnt(World* world, LiveEnt* ent)
+{
+	world->bodies.rest[ent->index] = 0;
+}
+
+bool isAsleep(World* world, LiveEnt* ent)
+{
+	return world->bodies.rest[ent->index] >= SLEEP_TICKS;
+}
+
+// wakes everything touching area, for when what it rests on changes under it
+void wakeArea(World* world, Rectangle area)
+{
+	int* candidates;
+	int candidatesLength = OSAKA_QuerySpatialHash(&world->broadphase,
+		(Rectangle){ area.x - WAKE_MARGIN, area.y - WAKE_MARGIN, area.width + WAKE_MARGIN * 2, area.height + WAKE_MARGIN * 2 }, &candidates);
+	
+	for (int i = 0; i < candidatesLength; i++)
+	{
+		wakeEnt(world, entAt(world, candidates[i]));
+	}
+}
+
+Rectangle bodyRect(World* world, LiveEnt* ent)
+{
+	return (Rectangle){ world->bodies.x[ent->index], world->bodies.y[ent->index], world->bodies.width[ent->index], world->bodies.height[ent->index] };
+}
+
+// counts the ticks a body has stayed at rest after moving and puts it to sleep once there are enough
+void settleEnt(World* world, LiveEnt* ent)
+{
+	int index = ent->index;
+	
+	if (!archetypeSleeps[ent->archetype] || ent == getEnt(world, world->selectedRune) ||
+		fabsf(world->bodies.dx[index]) >= SLEEP_VELOCITY || fabsf(world->bodies.dy[index]) >= SLEEP_VELOCITY)
+	{
+		world->bodies.rest[index] = 0;
+		return;
+	}
+	
+	// stopped dead so it wakes up exactly where it went to sleep
+	if (++world->bodies.rest[index] >= SLEEP_TICKS)
+	{
+		world->bodies.dx[index] = 0;
+		world->bodies.dy[index] = 0;
+	}
+}
+
+void liveEntUpdate(World* world, LiveEnt* ent)
+{
+	float step = OSAKA_GetTickTime() * BASE_TICK_RATE;	// velocities are in pixels per base tick
+	
+	// velocity was already integrated for every body by integrateBodies
+	if (world->bodies.dy[ent->index] < 0) ent->onGround = false;
+	
+	if (!sweepEnt(world, ent, false, step)) return;
+	if (!sweepEnt(world, ent, true, step)) return;
+	
+	// boundaries
+	float worldWidth = world->tilemap.width * TILE_SIZE;
+	float worldHeight = world->tilemap.height * TILE_SIZE;
+	
+	if (world->bodies.x[ent->index] < 0)
+	{
+		world->bodies.x[ent->index] = 0;
+	}
+	else if (world->bodies.x[ent->index] > worldWidth - world->bodies.width[ent->index])
+	{
+		if (ent->type || (world->currentLevel == 9 && getEnt(world, world->wizard)) || world->currentLevel == 10)
+		{
+			world->bodies.x[ent->index] = worldWidth - world->bodies.width[ent->index];
+		}
+		else
+		{
+			world->currentLevel++;
+			world->initLevel = true;
+		}
+	}
+	
+	if (world->bodies.y[ent->index] < 0)
+	{
+		world->bodies.y[ent->index] = 0;
+	}
+	else if (world->bodies.y[ent->index] > worldHeight - world->bodies.height[ent->index])
+	{
+		world->bodies.y[ent->index] = worldHeight - world->bodies.height[ent->index];
+	}
+
+	// reset forces for next frame
+    world->bodies.fx[ent->index] = 0;
+    world->bodies.fy[ent->index] = 0;
+}
+
+// indexed by archetype, a wizard is drawn as one more monster
+const int archetypeLayers[ARCHETYPES_LENGTH] = { LAYER_PLAYER, LAYER_MONSTERS, LAYER_MONSTERS, LAYER_PLATFORMS, LAYER_RUNES };
+
+void liveEntRender(World* world, LiveEnt* ent)
+{
+	// draw between the last two ticks so motion stays smooth when rendering faster than the tick rate
+	float alpha = OSAKA_GetInterpolation();
+	float x = world->bodies.prevX[ent->index] + (world->bodies.x[ent->index] - world->bodies.prevX[ent->index]) * alpha;
+	float y = world->bodies.prevY[ent->index] + (world->bodies.y[ent->index] - world->bodies.prevY[ent->index]) * alpha;
+	
+	OSAKA_DrawSprite(ent->imageIndex, (Rectangle){ x, y, world->bodies.width[ent->index]+2, world->bodies.height[ent->index]+2 }, WHITE,
+		archetypeLayers[ent->archetype], ent->facingRight ? 0 : SPRITE_FLIP_X);
+}
+
+void broadphaseSync(World* world, LiveEnt* ent)
+{
+	if (ent->initialised)
+	{
+		OSAKA_UpdateSpatialHash(&world->broadphase, ent->index, bodyRect(world, ent));
+	}
+	else
+	{
+		OSAKA_RemoveFromSpatialHash(&world->broadphase, ent->index);
+	}
+}
+
+// systems -------------------------------------------------------------------------------------------------------------
+
+// each archetype is stepped by its own loop over a dense list of just those entities, so the
+// tick calls straight into the code for that kind of entity instead of through a pointer per entity
+
+void playerSystem(World* world)
+{
+	int* ents = world->archetypeEnts[ARCHETYPE_PLAYER];
+	
+	for (int i = 0; i < world->archetypeEntsLength[ARCHETYPE_PLAYER]; i++)
+	{
+		LiveEnt* ent = entAt(world, ents[i]);
+		
+		if (ent->initialised) playerUpdate(world, ent);
+	}
+}
+
+void monsterSystem(World* world)
+{
+	int* ents = world->archetypeEnts[ARCHETYPE_MONSTER];
+	
+	for (int i = 0; i < world->archetypeEntsLength[ARCHETYPE_MONSTER]; i++)
+	{
+		LiveEnt* ent = entAt(world, ents[i]);
+		
+		if (ent->initialised) monsterUpdate(world, ent);
+	}
+}
+
+void wizardSystem(World* world)
+{
+	int* ents = world->archetypeEnts[ARCHETYPE_WIZARD];
+	
+	for (int i = 0; i < world->archetypeEntsLength[ARCHETYPE_WIZARD]; i++)
+	{
+		LiveEnt* ent = entAt(world, ents[i]);
+		
+		if (ent->initialised) wizardUpdate(world, ent);
+	}
+}
+
+void renderSystem(World* world, int archetype)
+{
+	int* ents = world->archetypeEnts[archetype];
+	
+	for (int i = 0; i < world->archetypeEntsLength[archetype]; i++)
+	{
+		LiveEnt* ent = entAt(world, ents[i]);
+		int index = ent->index;
+		
+		if (!ent->initialised) continue;
+		
+		// off camera, the padding covers the extra pixel drawn on each side and the interpolation back to prevX
+		if (fmaxf(world->bodies.x[index], world->bodies.prevX[index]) + world->bodies.width[index] + 2 < view.x || fminf(world->bodies.x[index], world->bodies.prevX[index]) > view.x + view.width ||
+			fmaxf(world->bodies.y[index], world->bodies.prevY[index]) + world->bodies.height[index] + 2 < view.y || fminf(world->bodies.y[index], world->bodies.prevY[index]) > view.y + view.height) continue;
+		
+		liveEntRender(world, ent);
+	}
+}
+
+// collisions are resolved in whatever order things move, so these pick the handler by archetype
+void entOnXCollision(World* world, LiveEnt* ent, LiveEnt* collider)
+{
+	switch (ent->archetype)
+	{
+		case ARCHETYPE_PLAYER: playerOnXCollision(world, ent, collider); break;
+		case ARCHETYPE_MONSTER:
+		case ARCHETYPE_WIZARD: monsterOnXCollision(world, ent, collider); break;
+		case ARCHETYPE_PLATFORM: platformOnXCollision(world, ent, collider); break;
+		case ARCHETYPE_RUNE: runeOnXCollision(world, ent, collider); break;
+	}
+}
+
+void entOnYCollision(World* world, LiveEnt* ent, LiveEnt* collider)
+{
+	switch (ent->archetype)
+	{
+		case ARCHETYPE_PLAYER: playerOnYCollision(world, ent, collider); break;
+		case ARCHETYPE_MONSTER:
+		case ARCHETYPE_WIZARD: monsterOnYCollision(world, ent, collider); break;
+		case ARCHETYPE_PLATFORM: platformOnYCollision(world, ent, collider); break;
+		case ARCHETYPE_RUNE: runeOnYCollision(world, ent, collider); break;
+	}
+}
+
+// a thrown rune landing on something scales it
+void touchRune(World* world, LiveEnt* ent, LiveEnt* rune)
+{
+	if (rune == getEnt(world, world->selectedRune)) return;
+	
+	// what rested on or against it is left floating or inside it once it changes size
+	wakeArea(world, bodyRect(world, ent));
+	
+	if (rune->scaleY > 1)
+	{
+		world->bodies.y[ent->index] -= world->bodies.height[ent->index];
+	}
+	
+	world->bodies.width[ent->index] *= rune->scaleX;
+	world->bodies.height[ent->index] *= rune->scaleY;
+	wakeArea(world, bodyRect(world, ent));
+	despawnEnt(world, rune);
+	playSound(world, 2);
+}
+
+// the player and a monster touching, whichever one ran into the other, the bigger one wins and a tie goes to the monster
+void touchMonster(World* world, LiveEnt* ent, LiveEnt* monster)
+{
+	if ((world->bodies.width[ent->index] + world->bodies.height[ent->index]) > (world->bodies.width[monster->index] + world->bodies.height[monster->index]))
+	{
+		despawnEnt(world, monster);
+		playSound(world, 4);
+	}
+	else
+	{
+		world->initLevel = true;
+		if (world->isHard) world->currentLevel = 0;
+		playSound(world, 4);
+	}
+}
+
+void blockX(World* world, LiveEnt* ent, LiveEnt* collider)
+{
+    if (world->bodies.dx[ent->index] > 0) {  // Moving right
+        world->bodies.x[ent->index] = world->bodies.x[collider->index] - world->bodies.width[ent->index];
+    } else if (world->bodies.dx[ent->index] < 0) {  // Moving left
+        world->bodies.x[ent->index] = world->bodies.x[collider->index] + world->bodies.width[collider->index];
+    }
+    world->bodies.dx[ent->index] = 0;  // Stop horizontal movement on collision
+    world->bodies.fx[ent->index] = 0;  // Reset horizontal force
+}
+
+void blockY(World* world, LiveEnt* ent, LiveEnt* collider)
+{
+	if (world->bodies.dy[ent->index] > 0) {  // Falling down
+        world->bodies.y[ent->index] = world->bodies.y[collider->index] - world->bodies.height[ent->index];
+        ent->onGround = true;  // Set a flag to indicate the entity is on the ground
+    } else if (world->bodies.dy[ent->index] < 0) {  // Moving up (jumping)
+        world->bodies.y[ent->index] = world->bodies.y[collider->index] + world->bodies.height[collider->index];
+    }
+    world->bodies.dy[ent->index] = 0;  // Stop vertical movement on collision
+    world->bodies.fy[ent->index] = 0;  // Reset vertical force
+}
+
+// player --------------------------------------------------------------------------------------------------------------
+
+void playerUpdate(World* world, LiveEnt* ent)
+{
+    if (isKeyDown(world, KEY_A) || isKeyDown(world, KEY_LEFT)){
+		world->bodies.fx[ent->index] = -100;
+		ent->facingRight = false;
+	}
+    if (isKeyDown(world, KEY_D) || isKeyDown(world, KEY_RIGHT)) {
+		world->bodies.fx[ent->index] = 100;
+		ent->facingRight = true;
+	}
+	if ((isKeyDown(world, KEY_W) || isKeyDown(world, KEY_SPACE) || isKeyDown(world, KEY_UP)) && ent->onGround)
+	{
+		jump(world, ent);
+	}
+	
+	if (isKeyDown(world, KEY_E)) pickUpRune(world, ent);
+	
+	LiveEnt* rune = getEnt(world, world->selectedRune);
+	
+	if (rune)
+	{
+		world->bodies.x[rune->index] = ent->facingRight ? world->bodies.x[ent->index] + world->bodies.width[ent->index] : world->bodies.x[ent->index] - world->bodies.width[rune->index];
+		world->bodies.y[rune->index] = world->bodies.y[ent->index];
+		world->bodies.prevX[rune->index] = world->bodies.x[rune->index];
+		world->bodies.prevY[rune->index] = world->bodies.y[rune->index];
+		
+		wakeEnt(world, rune);
+		broadphaseSync(world, rune);
+	}
+	
+	if (isMouseButtonPressed(world, MOUSE_LEFT_BUTTON) && rune)
+	{
+		world->bodies.fx[rune->index] = impulse(ent->facingRight ? 2500 : -2500);
+		world->bodies.fy[rune->index] = impulse(-3000);
+		
+		world->selectedRune = (EntHandle){0};
+		rune = NULL;
+		
+		playSound(world, 3);
+	}
+	
+	if (isMouseButtonPressed(world, MOUSE_RIGHT_BUTTON) && rune)
+	{
+		world->bodies.width[ent->index] *= rune->scaleX;
+		world->bodies.height[ent->index] *= rune->scaleY;
+		despawnEnt(world, rune);
+		world->selectedRune = (EntHandle){0};
+		
+		playSound(world, 2);
+	}
+	
+	if (isKeyDown(world, KEY_R))
+	{
+		world->initLevel = true;
+	}
+	
+	if (world->interactive) viewingAnalysis = isKeyDown(world, KEY_H);
+	
+	// remove later
+	//if (IsKeyDown(KEY_G))
+	//{
+//		currentLevel = LEVELS_LENGTH - 1;
+//initLevel = true;
+//	}
+}
+
+void jump(World* world, LiveEnt* ent)
+{
+	world->bodies.fy[ent->index] = impulse(-15000);
+}
+
+// a sleeping rune the player stands in never sweeps into it, so the player looks for one itself as well
+void pickUpRune(World* world, LiveEnt* ent)
+{
+	if (getEnt(world, world->selectedRune)) return;
+	
+	Rectangle area = bodyRect(world, ent);
+	int* candidates;
+	int candidatesLength = OSAKA_QuerySpatialHash(&world->broadphase, area, &candidates);
+	
+	for (int i = 0; i < candidatesLength; i++)
+	{
+		LiveEnt* candidate = entAt(world, candidates[i]);
+		
+		if (!candidate->initialised || candidate->archetype != ARCHETYPE_RUNE) continue;
+		
+		if (CheckCollisionRecs(area, bodyRect(world, candidate)))
+		{
+			runeOnPlayerCollision(world, candidate, ent);
+			return;
+		}
+	}
+}
+
+void playerOnXCollision(World* world, LiveEnt* ent, LiveEnt* collider)
+{
+	if (collider->type == 1) return;	// runes are picked up, not bumped into
+	
+	if (collider->type == 3)
+	{
+		touchMonster(world, ent, collider);
+		return;
+	}
+	
+	blockX(world, ent, collider);
+}
+
+void playerOnYCollision(World* world, LiveEnt* ent, LiveEnt* collider)
+{
+	if (collider->type == 1) return;
+	
+	if (collider->type == 3)
+	{
+		touchMonster(world, ent, collider);
+		return;
+	}
+	
+	blockY(world, ent, collider);
+}
+
+void playerOnTileXCollision(World* world, LiveEnt* ent, int tileX, int tileY)
+{
+	if (ent == getEnt(world, world->selectedRune)) return;
+	
+	if (OSAKA_GetTile(&world->tilemap, tileX, tileY) == 1)
+	{
+		if (world->bodies.dx[ent->index] > 0) {  // Moving right
+			world->bodies.x[ent->index] = tileX*TILE_SIZE - world->bodies.width[ent->index];
+			
+			if (ent->type == 3)
+			{
+				ent->facingRight = false;
+			}
+		} else if (world->bodies.dx[ent->index] < 0) {  // Moving left
+			world->bodies.x[ent->index] = tileX*TILE_SIZE + TILE_SIZE;
+			
+			if (ent->type == 3)
+			{
+				ent->facingRight = true;
+			}
+		}
+		world->bodies.dx[ent->index] = 0;  // Stop horizontal movement on collision
+		world->bodies.fx[ent->index] = 0;  // Reset horizontal force
+	}
+	
+	if (OSAKA_GetTile(&world->tilemap, tileX, tileY) == 2 && ent->type != 2)
+	{
+		if (ent->type == 0)
+		{
+			world->initLevel = true;
+			if (world->isHard) world->currentLevel = 0;
+			playSound(world, 4);
+		}
+		else
+		{
+			despawnEnt(world, ent);
+			
+			playSound(world, 4);
+		}
+			
+		return;
+	}
+	
+	
+}
+
+void playerOnTileYCollision(World* world, LiveEnt* ent, int tileX, int tileY)
+{
+	if (ent == getEnt(world, world->selectedRune)) return;
+	
+	if (OSAKA_GetTile(&world->tilemap, tileX, tileY))
+	{
+		if (world->bodies.dy[ent->index] > 0) {  // Falling down
+			world->bodies.y[ent->index] = tileY*TILE_SIZE - world->bodies.height[ent->index];
+			ent->onGround = true;  // Set a flag to indicate the entity is on the ground
+		} else if (world->bodies.dy[ent->index] < 0) {  // Moving up (jumping)
+			world->bodies.y[ent->index] = tileY*TILE_SIZE + TILE_SIZE;
+		}
+		world->bodies.dy[ent->index] = 0;  // Stop vertical movement on collision
+		world->bodies.fy[ent->index] = 0;  // Reset vertical force
+	}
+	
+	if (OSAKA_GetTile(&world->tilemap, tileX, tileY) == 2 && ent->type != 2)
+	{
+		if (ent->type == 0)
+		{
+			world->initLevel = true;
+			if (world->isHard) world->currentLevel = 0;
+			playSound(world, 4);
+		}
+		else
+		{
+			despawnEnt(world, ent);
+			playSound(world, 4);
+		}
+			
+		return;
+	}
+	
+	
+}
+
+void runeOnXCollision(World* world, LiveEnt* ent, LiveEnt* collider)
+{
+	if (!collider->type)
+	{
+		runeOnPlayerCollision(world, ent, collider);
+	}
+}
+
+void runeOnYCollision(World* world, LiveEnt* ent, LiveEnt* collider)
+{
+	if (!collider->type)
+	{
+		runeOnPlayerCollision(world, ent, collider);
+	}
+}
+
+void runeOnPlayerCollision(World* world, LiveEnt* ent, LiveEnt* collider)
+{
+	if (!getEnt(world, world->selectedRune) && isKeyDown(world, KEY_E))
+	{
+		playSound(world, 1);
+		world->selectedRune = entHandle(ent);
+	}
+}
+
+void monsterUpdate(World* world, LiveEnt* ent)
+{
+	world->bodies.fx[ent->index] = ent->facingRight ? 200 : -200;
+}
+
+void monsterOnXCollision(World* world, LiveEnt* ent, LiveEnt* collider)
+{
+	if (collider->type == 0)
+	{
+		touchMonster(world, collider, ent);
+		return;
+	}
+	
+	if (collider->type == 1)
+	{
+		touchRune(world, ent, collider);
+		return;
+	}
+	
+	// walk back the other way
+	if (world->bodies.dx[ent->index] > 0) ent->facingRight = false;
+	else if (world->bodies.dx[ent->index] < 0) ent->facingRight = true;
+	
+	blockX(world, ent, collider);
+}
+
+void monsterOnYCollision(World* world, LiveEnt* ent, LiveEnt* collider)
+{
+	if (collider->type == 0)
+	{
+		touchMonster(world, collider, ent);
+		return;
+	}
+	
+	if (collider->type == 1)
+	{
+		touchRune(world, ent, collider);
+		return;
+	}
+	
+	blockY(world, ent, collider);
+}
+
+void wizardUpdate(World* world, LiveEnt* ent)
+{
+	LiveEnt* target = getEnt(world, world->player);
+	
+	if (!target) return;
+	
+	// Calculate the direction vector from the follower to the target
+    float directionX = world->bodies.x[target->index] - world->bodies.x[ent->index];
+    float directionY = world->bodies.y[target->index] - world->bodies.y[ent->index];
+
+    // Calculate the distance between the two entities
+    float distance = sqrt(directionX * directionX + directionY * directionY);
+
+    // Normalize the direction vector
+    if (distance != 0) {
+        directionX /= distance;
+        directionY /= distance;
+    }
+
+    // Apply the direction vector to the follower's force, scaled by speed
+    world->bodies.fx[ent->index] = directionX * 50;
+    world->bodies.fy[ent->index] = directionY * 800;
+	
+	ent->facingRight = world->bodies.fx[ent->index] > 0;
+	
+}
+
+void platformOnXCollision(World* world, LiveEnt* ent, LiveEnt* collider)
+{
+	if (collider->type == 1)
+	{
+		touchRune(world, ent, collider);
+		return;
+	}
+	
+	blockX(world, ent, collider);
+}
+
+void platformOnYCollision(World* world, LiveEnt* ent, LiveEnt* collider)
+{
+	if (collider->type == 1)
+	{
+		touchRune(world, ent, collider);
+		return;
+	}
+	
+	blockY(world, ent, collider);
+}
+
+
+
+// run -----------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+	bool runHeadless = false;
+	bool runBench = false;
+	bool runCheck = false;
+	char* recordFileName = NULL;
+	char* replayFileName = NULL;
+	
+	for (int i = 1; i < argc; i++)
+	{
+		if (!strcmp(argv[i], "--headless")) runHeadless = true;
+		else if (!strcmp(argv[i], "--level") && i + 1 < argc) headlessLevel = atoi(argv[++i]) - 1;
+		else if (!strcmp(argv[i], "--ticks") && i + 1 < argc) headlessTicks = atoll(argv[++i]);
+		else if (!strcmp(argv[i], "--runs") && i + 1 < argc) headlessRuns = atoll(argv[++i]);
+		else if (!strcmp(argv[i], "--worlds") && i + 1 < argc) headlessWorlds = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "--fps") && i + 1 < argc) OSAKA_SetRenderRate(atoi(argv[++i]));
+		else if (!strcmp(argv[i], "--tick-rate") && i + 1 < argc) OSAKA_SetTickRate(atoi(argv[++i]));
+		else if (!strcmp(argv[i], "--profile") && i + 1 < argc) profileFileName = argv[++i];
+		else if (!strcmp(argv[i], "--record") && i + 1 < argc) recordFileName = argv[++i];
+		else if (!strcmp(argv[i], "--replay") && i + 1 < argc) replayFileName = argv[++i];
+		else if (!strcmp(argv[i], "--bench")) runBench = true;
+		else if (!strcmp(argv[i], "--check-jumps")) runCheck = true;
+		else if (!strcmp(argv[i], "--bench-ents") && i + 1 < argc)
+		{
+			if (!parseBenchEnts(argv[++i])) return 1;
+		}
+		else if (!strcmp(argv[i], "--bench-mix") && i + 1 < argc)
+		{
+			if (sscanf(argv[++i], "%i,%i,%i", &benchMix[0], &benchMix[1], &benchMix[2]) != 3 ||
+				benchMix[0] < 0 || benchMix[1] < 0 || benchMix[2] < 0 || !(benchMix[0] + benchMix[1] + benchMix[2]))
+			{
+				TraceLog(LOG_ERROR, "could not read bench mix, expected monsters,runes,platforms weights (mix : %s)", argv[i]);
+				return 1;
+			}
+		}
+		else if (!strcmp(argv[i], "--bench-tiles") && i + 1 < argc) benchTiles = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "--bench-grid") && i + 1 < argc)
+		{
+			if (sscanf(argv[++i], "%ix%i", &benchGridWidth, &benchGridHeight) != 2 || benchGridWidth < 2 || benchGridHeight < 3)
+			{
+				TraceLog(LOG_ERROR, "could not read bench grid, expected widthxheight of at least 2x3 (grid : %s)", argv[i]);
+				return 1;
+			}
+		}
+		else if (!strcmp(argv[i], "--bench-ticks") && i + 1 < argc) benchTicks = atoll(argv[++i]);
+		else if (!strcmp(argv[i], "--bench-seed") && i + 1 < argc) benchSeed = strtoul(argv[++i], NULL, 10);
+		else if (!strcmp(argv[i], "--bench-throw") && i + 1 < argc) benchThrow = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "--build-levels") && i + 1 < argc)
+		{
+			return OSAKA_SaveLevelPack(argv[++i], builtinLevels, LEVELS_LENGTH) ? 0 : 1;
+		}
+		else if (!strcmp(argv[i], "--build-assets") && i + 1 < argc)
+		{
+			return OSAKA_SaveAssetPack(argv[++i], RESOURCES_PATH) ? 0 : 1;
+		}
+	}
+	
+	if (runCheck)
+	{
+		OSAKA_InitHeadless();
+		init();
+		
+		bool passed = checkJumps();
+		
+		quit();
+		OSAKA_Quit(passed ? 0 : 1);
+	}
+	
+	if (runBench)
+	{
+		if (benchTicks < 1) benchTicks = 1;
+		
+		OSAKA_RunHeadless(benchInit, benchUpdate, benchQuit, 0);
+	}
+	
+	OSAKA_SetWorldHash(worldHash);
+	
+	if (recordFileName) OSAKA_StartRecording(recordFileName);
+	if (replayFileName && !OSAKA_StartReplay(replayFileName)) return 1;
+	
+	// a replay starts from the menu like the session it was recorded from, not from the headless level cycle
+	if (runHeadless && replayFileName) OSAKA_RunHeadless(init, update, quit, 0);
+	
+	if (runHeadless)
+	{
+		if (headlessLevel >= LEVELS_PLAYABLE) headlessLevel = -1;
+		if (headlessRuns < 1) headlessRuns = 1;
+		
+		// a sweep steps its own worlds rather than ticking the engine, so it reports its own throughput
+		if (headlessWorlds != 1)
+		{
+			OSAKA_InitHeadless();
+			init();
+			headlessSweep();
+			headlessQuit();
+			OSAKA_Quit(0);
+		}
+		
+		OSAKA_RunHeadless(headlessInit, headlessUpdate, headlessQuit, 0);
+	}
+	
+	OSAKA_Run("RUNESCALER", SCREEN_WIDTH, SCREEN_HEIGHT, init, update, render, quit);
+
+    return 0;
+}
+
+void init()
+{
+	OSAKA_LoadTextureAsync(TEXTURES_PATH "tile0.png", 1, ASSET_GROUP_STARTUP);
+	OSAKA_LoadTextureAsync(TEXTURES_PATH "tile1.png", 2, ASSET_GROUP_STARTUP);
+	OSAKA_LoadTextureAsync(TEXTURES_PATH "player.png", 3, ASSET_GROUP_STARTUP);
+	OSAKA_LoadTextureAsync(TEXTURES_PATH "platform.png", 5, ASSET_GROUP_STARTUP);
+	OSAKA_LoadTextureAsync(TEXTURES_PATH "2H.png", 6, ASSET_GROUP_STARTUP);
+	OSAKA_LoadTextureAsync(TEXTURES_PATH "1H.png", 7, ASSET_GROUP_STARTUP);
+	OSAKA_LoadTextureAsync(TEXTURES_PATH "2A.png", 8, ASSET_GROUP_STARTUP);
+	OSAKA_LoadTextureAsync(TEXTURES_PATH "1A.png", 9, ASSET_GROUP_STARTUP);
+	OSAKA_LoadTextureAsync(TEXTURES_PATH "2V.png", 10, ASSET_GROUP_STARTUP);
+	OSAKA_LoadTextureAsync(TEXTURES_PATH "1V.png", 11, ASSET_GROUP_STARTUP);
+	OSAKA_LoadTextureAsync(TEXTURES_PATH "monster.png", 12, ASSET_GROUP_STARTUP);
+	OSAKA_LoadTextureAsync(TEXTURES_PATH "spike.png", 14, ASSET_GROUP_STARTUP);
+	OSAKA_LoadTextureAsync(TEXTURES_PATH "wizard.png", 15, ASSET_GROUP_STARTUP);
+	OSAKA_LoadTextureAsync(TEXTURES_PATH "end.png", 17, ASSET_GROUP_STARTUP);
+	OSAKA_LoadTextureAsync(TEXTURES_PATH "menu.png", 18, ASSET_GROUP_STARTUP);
+	OSAKA_LoadTextureAsync(TEXTURES_PATH "start.png", 19, ASSET_GROUP_STARTUP);
+	OSAKA_LoadTextureAsync(TEXTURES_PATH "runeanalysis.png", 20, ASSET_GROUP_STARTUP);
+	
+	OSAKA_LoadMusicAsync(MUSIC_PATH "music.mp3", 1, ASSET_GROUP_STARTUP);
+	OSAKA_LoadMusicAsync(MUSIC_PATH "battlemusic.mp3", 2, ASSET_GROUP_STARTUP);
+	OSAKA_LoadMusicAsync(MUSIC_PATH "menumusic.mp3", 3, ASSET_GROUP_STARTUP);
+	
+	OSAKA_LoadSoundAsync(SOUNDS_PATH "pickupCoin.wav", 1, ASSET_GROUP_STARTUP);
+	OSAKA_LoadSoundAsync(SOUNDS_PATH "powerUp.wav", 2, ASSET_GROUP_STARTUP);
+	OSAKA_LoadSoundAsync(SOUNDS_PATH "throw.wav", 3, ASSET_GROUP_STARTUP);
+	OSAKA_LoadSoundAsync(SOUNDS_PATH "death.wav", 4, ASSET_GROUP_STARTUP);
+	
+	// a pile of monsters landing on spikes together should not drown out the player's own death or throws
+	OSAKA_SetSoundVoices(1, 2, 0);
+	OSAKA_SetSoundVoices(2, 2, 0);
+	OSAKA_SetSoundVoices(3, 3, 1);
+	OSAKA_SetSoundVoices(4, 3, 2);
+	
+	// everything decodes in parallel, so start up takes as long as the slowest file rather than all of them
+	OSAKA_WaitForGroup(ASSET_GROUP_STARTUP);
+	
+	// tiles and sprites share an atlas, the full screen pictures are drawn on their own anyway
+	for (int i = 1; i <= 16; i++)
+	{
+		OSAKA_AddToAtlas(i);
+	}
+	
+	OSAKA_BuildAtlas();
+	
+	OSAKA_InitText(&levelNumberText, HUD_FONT, 25, LIGHTGRAY, LAYER_TEXT);
+	OSAKA_InitText(&timeText, HUD_FONT, 25, LIGHTGRAY, LAYER_TEXT);
+	OSAKA_InitText(&statsText, HUD_FONT, 25, LIGHTGRAY, LAYER_TEXT);
+	
+	OSAKA_SetMusicCrossfade(MUSIC_CROSSFADE);
+	OSAKA_PlayMusic(3);
+	OSAKA_CueMusic(1);		// the first level's, so leaving the menu does not wait on a decode
+	
+	initWorld(&game, true);
+	
+	if (!OSAKA_OpenLevelPack(&levelPack, LEVEL_PACK_FILE_NAME))
+	{
+		size_t size = 0;
+		void* data = OSAKA_BuildLevelPack(builtinLevels, LEVELS_LENGTH, &size);
+		
+		TraceLog(LOG_WARNING, "using built in levels");
+		OSAKA_OpenLevelPackFromMemory(&levelPack, data, size);
+	}
+	
+	game.currentLevel = 11;
+	game.initLevel = true;
+}
+
+// levels --------------------------------------------------------------------------------------------------------------
+
+// the levels the game ships with, written out by --build-levels and used as is when there is no level pack
+const unsigned char level1Tiles[GRID_HEIGHT][GRID_WIDTH] = {
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+	{1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}
+};
+
+const LevelSpawn level1Spawns[] = {
+	SPAWN_PLAYER(0, 625, 126, 126),
+	SPAWN_RUNE(300, 765, 1, 0.5)
+};
+
+const unsigned char level2Tiles[GRID_HEIGHT][GRID_WIDTH] = {
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+	{1,1,2,2,1,1,2,2,1,1,2,2,1,1,2,2,1,1,1}
+};
+
+const LevelSpawn level2Spawns[] = {
+	SPAWN_PLAYER(0, 625, 62, 124),
+	SPAWN_RUNE(1100, 700, 1, 0.5)
+};
+
+const unsigned char level3Tiles[GRID_HEIGHT][GRID_WIDTH] = {
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,1,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,1,0,0,0,0,1,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,1,0,0,0,0,1,0,0,0,0,0,1},
+	{0,0,1,0,0,0,0,1,0,0,0,0,1,1,0,0,0,0,1},
+	{0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,0,0},
+	{0,0,1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,0,0},
+	{1,1,1,2,2,2,2,1,2,2,2,2,1,2,2,2,1,1,1}
+};
+
+const LevelSpawn level3Spawns[] = {
+	SPAWN_PLAYER(0, 700, 64, 60),
+	SPAWN_RUNE(1100, 250, 1, 0.5),
+	SPAWN_PLATFORM(1152, 700, 62, 114)
+};
+
+const unsigned char level4Tiles[GRID_HEIGHT][GRID_WIDTH] = {
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2},
+	{1,1,1,1,0,0,0,1,1,0,0,0,0,1,0,0,0,0,2},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2},
+	{0,0,0,0,0,1,1,0,0,0,0,0,1,1,0,0,0,0,2},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2},
+	{0,0,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+	{0,0,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+	{1,1,1,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2}
+};
+
+const LevelSpawn level4Spawns[] = {
+	SPAWN_PLAYER(0, 700, 64, 62),
+	SPAWN_RUNE(0, 0, 2, 1),
+	SPAWN_RUNE(64, 0, 2, 1),
+	SPAWN_RUNE(128, 0, 2, 1),
+	SPAWN_RUNE(192, 0, 2, 1),
+	SPAWN_PLATFORM(193, 765, 62, 62)
+};
+
+const unsigned char level5Tiles[GRID_HEIGHT][GRID_WIDTH] = {
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2},
+	{0,0,0,1,0,0,0,0,0,0,0,0,0,1,0,0,0,0,2},
+	{1,1,1,1,1,1,1,1,1,1,1,1,1,1,0,0,0,0,2},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,1,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,1,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,1,0,0,0,0,0,0},
+	{1,1,1,2,2,2,2,2,2,2,2,2,1,1,1,1,1,1,1}
+};
+
+const LevelSpawn level5Spawns[] = {
+	SPAWN_PLAYER(0, 700, 70, 30),
+	SPAWN_RUNE(0, 0, 1, 2),
+	SPAWN_RUNE(64, 0, 1, 0.5),
+	SPAWN_PLATFORM(1152, 705, 62, 20),
+	SPAWN_MONSTER(900, 700, 70, 34, 0),
+	SPAWN_MONSTER(256, 0, 70, 34, 0)
+};
+
+const unsigned char level6Tiles[GRID_HEIGHT][GRID_WIDTH] = {
+	{0,0,0,0,0,0,0,2,0,0,0,0,0,2,0,0,0,0,1},
+	{0,0,0,0,2,0,0,0,0,0,2,0,0,0,0,0,0,0,1},
+	{1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,0,0,1},
+	{0,0,0,0,2,2,0,0,0,0,0,0,0,0,2,2,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,1,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1,1},
+	{0,0,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1},
+	{0,0,0,2,2,0,0,0,0,0,0,0,0,2,2,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,1,0,0,0,0,0,0,0,0,1,0,0,0,0,1,0,0},
+	{1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}
+};
+
+const LevelSpawn level6Spawns[] = {
+	SPAWN_PLAYER(0, 0, 62, 62),
+	SPAWN_RUNE(1080, 290, 1, 2),
+	SPAWN_MONSTER(256, 380, 62, 62, 0),
+	SPAWN_MONSTER(832, 600, 124, 124, 0),
+	SPAWN_MONSTER(256, 650, 64, 60, 0)
+};
+
+const unsigned char level7Tiles[GRID_HEIGHT][GRID_WIDTH] = {
+	{1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,0,0,0,1},
+	{1,1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+	{1,1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{1,0,0,0,0,1,1,1,1,1,1,1,1,1,1,1,1,1,1},
+	{1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2},
+	{1,1,1,0,0,0,0,0,0,0,0,0,0,0,1,0,0,0,2},
+	{1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,0,0,0,2},
+	{0,0,0,0,0,2,0,0,0,0,0,0,0,0,0,0,0,0,2},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,1,1,1,0,0,2},
+	{0,0,0,0,0,0,0,0,0,1,1,0,0,1,1,1,0,0,2},
+	{1,1,2,2,1,1,1,2,2,1,1,2,2,1,1,1,2,2,2}
+};
+
+const LevelSpawn level7Spawns[] = {
+	SPAWN_PLAYER(0, 700, 60, 60),
+	SPAWN_MONSTER(832, 0, 90, 63, SPAWN_FACING_LEFT),
+	SPAWN_RUNE(686, 384, 2, 2),
+	SPAWN_RUNE(70, 320, 1, 0.5)
+};
+
+const unsigned char level8Tiles[GRID_HEIGHT][GRID_WIDTH] = {
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+	{0,0,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,1,1,1,1,1,1,1,1,1,1,1,1,0,1,1,1,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,1,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,1,0,0,0,0,1},
+	{1,0,0,0,0,0,0,0,0,0,0,0,0,1,0,0,0,0,1},
+	{1,1,0,0,0,0,0,0,0,1,1,1,1,1,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{1,1,1,1,2,2,2,2,2,1,1,2,2,2,2,2,2,2,1}
+};
+
+const LevelSpawn level8Spawns[] = {
+	SPAWN_PLAYER(0, 700, 59, 60),
+	SPAWN_PLATFORM(897, 127, 58, 630),
+	SPAWN_MONSTER(400, 0, 110, 64, 0),
+	SPAWN_MONSTER(600, 0, 110, 64, 0),
+	SPAWN_RUNE(644, 320, 0.5, 1),
+	SPAWN_RUNE(708, 320, 0.5, 1),
+	SPAWN_RUNE(772, 320, 1, 0.5)
+};
+
+const unsigned char level9Tiles[GRID_HEIGHT][GRID_WIDTH] = {
+	{2,0,0,0,0,0,0,0,2,0,0,0,0,0,0,0,0,0,1},
+	{2,0,0,0,0,0,0,0,2,0,0,0,0,0,0,0,0,0,1},
+	{2,0,0,0,0,0,0,0,2,0,0,0,0,0,0,0,0,0,1},
+	{2,0,0,0,2,0,0,0,2,0,0,0,0,0,0,0,0,0,1},
+	{1,1,0,0,2,0,0,0,1,1,1,1,0,0,2,2,2,1,1},
+	{2,0,0,0,2,0,0,0,2,0,0,0,0,0,0,0,0,0,1},
+	{2,0,0,0,2,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{2,0,0,0,2,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{2,0,0,1,1,1,0,0,1,1,1,1,1,1,1,1,0,1,1},
+	{2,0,0,0,1,0,0,0,0,0,0,0,0,0,0,1,0,0,1},
+	{0,0,0,0,1,0,0,0,0,0,0,0,0,0,0,1,0,0,1},
+	{0,0,0,0,1,0,0,0,0,1,0,0,0,0,0,1,0,0,0},
+	{1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}
+};
+
+const LevelSpawn level9Spawns[] = {
+	SPAWN_PLAYER(0, 700, 57, 57),
+	SPAWN_PLATFORM(1025, 650, 26, 254),
+	SPAWN_MONSTER(385, 630, 62, 124, 0),
+	SPAWN_RUNE(1100, 192, 2, 2),
+	SPAWN_RUNE(768, 700, 0.5, 0.5),
+	SPAWN_RUNE(832, 700, 0.5, 1)
+};
+
+const unsigned char level10Tiles[GRID_HEIGHT][GRID_WIDTH] = {
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1},
+	{0,0,0,0,0,0,0,0,1,1,1,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}
+};
+
+const LevelSpawn level10Spawns[] = {
+	SPAWN_PLAYER(0, 700, 28, 28),
+	SPAWN_RUNE(16, 64, 1, 0.5),
+	SPAWN_RUNE(80, 320, 1, 2),
+	SPAWN_RUNE(1104, 64, 2, 1),
+	SPAWN_RUNE(1040, 320, 0.5, 1),
+	SPAWN_RUNE(528, 128, 0.5, 0.5),
+	SPAWN_RUNE(656, 128, 2, 2),
+	SPAWN_WIZARD(700, 700, 256, 256)
+};
+
+const unsigned char level11Tiles[GRID_HEIGHT][GRID_WIDTH] = {
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+	{1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}
+};
+
+const LevelSpawn level11Spawns[] = {
+	SPAWN_PLAYER(200, 625, 126, 126),
+	SPAWN_RUNE(300, 765, 1, 0.5),
+	SPAWN_RUNE(400, 765, 1, 2),
+	SPAWN_RUNE(500, 765, 2, 1),
+	SPAWN_RUNE(600, 765, 0.5, 1),
+	SPAWN_RUNE(700, 765, 0.5, 0.5),
+	SPAWN_RUNE(800, 765, 2, 2)
+};
+
+const unsigned char menuTiles[GRID_HEIGHT][GRID_WIDTH] = {
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+	{1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}
+};
+
+const Level builtinLevels[LEVELS_LENGTH] = {
+	{ GRID_WIDTH, GRID_HEIGHT, &level1Tiles[0][0], level1Spawns, LENGTH(level1Spawns), 1, 0,
+		"WASD or arrow keys to move\n\n\nE to pick up runes\n\n\nLEFT CLICK to throw runes\n\n\nRIGHT CLICK to use runes\n\n\nR to restart the level\n\n\nH to view Zebolios' rune research", 15, 15, 40, { 200, 200, 200, 255 } },
+	{ GRID_WIDTH, GRID_HEIGHT, &level2Tiles[0][0], level2Spawns, LENGTH(level2Spawns), 0, 2,
+		"Avoid the red blocks", 15, 15, 40, { 200, 200, 200, 255 } },
+	{ GRID_WIDTH, GRID_HEIGHT, &level3Tiles[0][0], level3Spawns, LENGTH(level3Spawns), 0, 0,
+		"Throwing runes on objects makes them shrink or grow", 15, 15, 40, { 200, 200, 200, 255 } },
+	{ GRID_WIDTH, GRID_HEIGHT, &level4Tiles[0][0], level4Spawns, LENGTH(level4Spawns), 0, 0,
+		"Runes have different effects based on their appearance", 15, 15, 40, { 200, 200, 200, 255 } },
+	{ GRID_WIDTH, GRID_HEIGHT, &level5Tiles[0][0], level5Spawns, LENGTH(level5Spawns), 0, 2,
+		"Be careful of monsters, unless you're bigger than them", 15, 15, 40, { 200, 200, 200, 255 } },
+	{ GRID_WIDTH, GRID_HEIGHT, &level6Tiles[0][0], level6Spawns, LENGTH(level6Spawns), 0, 2,
+		NULL, 0, 0, 0, { 0 } },
+	{ GRID_WIDTH, GRID_HEIGHT, &level7Tiles[0][0], level7Spawns, LENGTH(level7Spawns), 0, 0,
+		NULL, 0, 0, 0, { 0 } },
+	{ GRID_WIDTH, GRID_HEIGHT, &level8Tiles[0][0], level8Spawns, LENGTH(level8Spawns), 0, 2,
+		NULL, 0, 0, 0, { 0 } },
+	{ GRID_WIDTH, GRID_HEIGHT, &level9Tiles[0][0], level9Spawns, LENGTH(level9Spawns), 0, 0,
+		NULL, 0, 0, 0, { 0 } },
+	{ GRID_WIDTH, GRID_HEIGHT, &level10Tiles[0][0], level10Spawns, LENGTH(level10Spawns), 2, 2,
+		NULL, 0, 0, 0, { 0 } },
+	{ GRID_WIDTH, GRID_HEIGHT, &level11Tiles[0][0], level11Spawns, LENGTH(level11Spawns), 3, 2,
+		"you escaped! thanks for playing!", 230, 15, 40, { 130, 130, 130, 255 } },
+	{ GRID_WIDTH, GRID_HEIGHT, &menuTiles[0][0], NULL, 0, 0, 0,
+		NULL, 0, 0, 0, { 0 } }
+};
+
+// the tilemap and entities of a level from scratch, what a level start snapshot is taken of
+bool buildLevel(World* world, int index, Level level)
+{
+	OSAKA_FreeTilemap(&world->tilemap);
+	
+	world->levelIndex = -1;
+	
+	// the cells stay in the pack and are pulled in chunk by chunk as they are needed
+	if (!OSAKA_InitTilemap(&world->tilemap, level.gridWidth, level.gridHeight, TILE_SIZE, level.tiles)) return false;
+	
+	// reset entities
+	clearEnts(world);
+	
+	for (int i = 0; i < level.spawnsLength; i++)
+	{
+		const LevelSpawn* spawn = &level.spawns[i];
+		EntHandle ent = {0};
+		
+		switch (spawn->type)
+		{
+			case ARCHETYPE_PLAYER: ent = world->player = createPlayer(world, spawn->x, spawn->y, spawn->width, spawn->height); break;
+			case ARCHETYPE_MONSTER: ent = createMonster(world, spawn->x, spawn->y, spawn->width, spawn->height); break;
+			case ARCHETYPE_WIZARD: ent = world->wizard = createWizard(world, spawn->x, spawn->y, spawn->width, spawn->height); break;
+			case ARCHETYPE_PLATFORM: ent = createPlatform(world, spawn->x, spawn->y, spawn->width, spawn->height); break;
+			case ARCHETYPE_RUNE: ent = createItem(world, spawn->x, spawn->y, spawn->scaleX, spawn->scaleY); break;
+			default: TraceLog(LOG_WARNING, "skipped spawn, unknown type (level : %i) (spawn : %i) (type : %i)", index, i, spawn->type); break;
+		}
+		
+		LiveEnt* spawned = getEnt(world, ent);
+		
+		if (spawned && (spawn->flags & SPAWN_FACING_LEFT)) spawned->facingRight = false;
+	}
+	
+	world->levelIndex = index;
+	
+	return true;
+}
+
+// the next level's music is decoded ahead while this one plays, levels that keep the current track have nothing to cue
+void cueNextMusic(int index)
+{
+	Level next;
+	
+	if (index + 1 >= levelPack.levelsLength || !OSAKA_GetLevel(&levelPack, index + 1, &next)) return;
+	
+	if (next.music > 0 && next.music < MUSIC_LENGTH) OSAKA_CueMusic(next.music);
+}
+
+void loadLevel(World* world, int index)
+{
+	Level level;
+	
+	if (!OSAKA_GetLevel(&levelPack, index, &level)) return;
+	
+	// a level is only built the first time, starting it over after that is a copy back out of its start snapshot
+	if (!restoreLevelStart(world, index))
+	{
+		if (!buildLevel(world, index, level)) return;
+		
+		saveLevelStart(world, index);
+	}
+	
+	if (world->interactive)
+	{
+		if (level.music > 0 && level.music < MUSIC_LENGTH) OSAKA_SwitchMusic(level.music);
+		
+		cueNextMusic(index);
+	}
+	
+	if (level.sound) playSound(world, level.sound);
+	
+	world->level = level;
+	
+	if (!world->interactive) return;
+	
+	OSAKA_InitText(&levelText, HUD_FONT, level.textSize, level.textColor, LAYER_TEXT);
+	OSAKA_SetText(&levelText, level.text);
+}
+
+// the floor on the right of the boss room drops away once the wizard is dead
+void openBossExit(World* world)
+{
+	int levelgrid[GRID_HEIGHT][GRID_WIDTH] = {
+		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+		{1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1},
+		{0,0,0,0,0,0,0,0,1,1,1,0,0,0,0,0,0,0,1},
+		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
+		{1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1,1},
+		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+		{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+		{1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1}
+	};
+	
+	setGrid(world, levelgrid);
+}
+
+EntHandle createPlayer(World* world, int x, int y, int width, int height)
+{
+	LiveEnt player = {
+		0,true,true,0,0,0, false,3, ARCHETYPE_PLAYER, 0, 0, 0 };
+		
+	return spawnEnt(world, player, x, y, width, height);
+}
+
+EntHandle createMonster(World* world, int x, int y, int width, int height)
+{
+	LiveEnt mosnter = {
+		0,true,true,3,0,0, false,12, ARCHETYPE_MONSTER, 0, 0, 0 };
+		
+	return spawnEnt(world, mosnter, x, y, width, height);
+}
+
+EntHandle createWizard(World* world, int x, int y, int width, int height)
+{
+	// a monster as far as anything touching it is concerned, it just chases the player instead of pacing
+	LiveEnt wizard = {
+		0,true,true,3,0,0, false,15, ARCHETYPE_WIZARD, 0, 0, 0 };
+		
+	return spawnEnt(world, wizard, x, y, width, height);
+}
+
+EntHandle createPlatform(World* world, int x, int y, int width, int height)
+{
+	LiveEnt platform = {
+		0,true,true,2,0,0, false,5, ARCHETYPE_PLATFORM, 0, 0, 0 };
+		
+	return spawnEnt(world, platform, x, y, width, height);
+}
+
+EntHandle createItem(World* world, int x, int y, float scaleX, float scaleY)
+{
+	int imageIndex = 0;
+	
+	if (scaleX == 2 && scaleY == 1) imageIndex = 6;
+	else if (scaleX == 0.5 && scaleY == 1) imageIndex = 7;
+	else if (scaleX == 2 && scaleY == 2) imageIndex = 8;
+	else if (scaleX == 0.5 && scaleY == 0.5) imageIndex = 9;
+	else if (scaleX == 1 && scaleY == 2) imageIndex = 10;
+	else if (scaleX == 1 && scaleY == 0.5) imageIndex = 11;
+	
+	LiveEnt item = {
+		0,true,true,1,scaleX,scaleY, false,imageIndex, ARCHETYPE_RUNE, 0, 0, 0 };
+		
+	return spawnEnt(world, item, x, y, TILE_SIZE/2, TILE_SIZE/2);
+}
+
+
+// read on the tick rather than while drawing so the menu choices are recorded with everything else
+void menuUpdate()
+{
+	if (!viewingStory)
+	{
+		if (OSAKA_IsKeyDown(KEY_ONE))
+		{
+			viewingStory = true;
+			game.isHard = false;
+		}
+		
+		if (OSAKA_IsKeyDown(KEY_TWO))
+		{
+			viewingStory = true;
+			game.isHard = true;
+		}
+	}
+	else if (OSAKA_IsKeyDown(KEY_ENTER))
+	{
+		game.currentLevel = 0;
+		game.initLevel = true;
+		
+		OSAKA_SwitchMusic(1);
+	}
+}
+
+void update()
+{
+	if (game.currentLevel == 11) menuUpdate();
+	
+	stepWorld(&game);
+}
+
+// a tick of one world, starting its level over first when something asked for that on the last one
+void stepWorld(World* world)
+{
+	if (world->initLevel)
+	{
+		world->selectedRune = (EntHandle){0};
+		loadLevel(world, world->currentLevel);
+		world->initLevel = false;
+		
+		for (int i = 0; i < world->aliveEntsLength; i++)
+		{
+			broadphaseSync(world, entAt(world, world->aliveEnts[i]));
+		}
+		
+		// rewinding goes no further back than the start of the level
+		clearRewind(world);
+		if (world->interactive) pushRewind(world);
+	}
+	
+	if (world->currentLevel < 10) world->atime += OSAKA_GetTickTime();
+	
+	// the clock keeps running while rewinding so it never wins back time
+	if (isKeyDown(world, KEY_Q) && rewindWorld(world)) return;
+	
+	world->rewinding = 0;
+	
+	simulate(world);
+	
+	streamTiles(world);
+	
+	if (world->currentLevel == 9 && world->wizard.generation && !getEnt(world, world->wizard))
+	{
+		world->wizard = (EntHandle){0};
+		openBossExit(world);
+	}
+	
+	if (++world->ticks % REWIND_INTERVAL == 0 && world->interactive) pushRewind(world);
+}
+
+// one tick of every entity, what the bench times
+void simulate(World* world)
+{
+	// every entity's input first so the forces are all in place for the batched integration,
+	// platforms and runes only ever move by being pushed so they have no system here
+	PROFILE_BEGIN("systems");
+	playerSystem(world);
+	monsterSystem(world);
+	wizardSystem(world);
+	PROFILE_END();
+	
+	PROFILE_BEGIN("integrate");
+	integrateBodies(&world->bodies, world->entSlotsLength, OSAKA_GetTickTime(), world->currentLevel == 8 ? 20 : 0);
+	PROFILE_END();
+	
+	PROFILE_BEGIN("collisions");
+	
+	for (int i = 0; i < world->aliveEntsLength; i++)
+	{
+		LiveEnt* ent = entAt(world, world->aliveEnts[i]);
+		
+        if (ent->initialised && !isAsleep(world, ent))
+		{
+			liveEntUpdate(world, ent);
+			
+			// later entities collide against where this one ended up
+			broadphaseSync(world, ent);
+			
+			if (ent->initialised) settleEnt(world, ent);
+		}
+    }
+	
+	PROFILE_END();
+	
+	// drop anything killed this tick
+	flushEnts(world);
+}
+
+// chunks around the player are loaded before the camera gets to them and the ones left behind are let go
+void streamTiles(World* world)
+{
+	LiveEnt* ent = getEnt(world, world->player);
+	
+	if (!ent) return;
+	
+	Vector2 target = cameraTarget(world, world->bodies.x[ent->index] + world->bodies.width[ent->index] / 2, world->bodies.y[ent->index] + world->bodies.height[ent->index] / 2);
+	float margin = TILEMAP_CHUNK_SIZE * TILE_SIZE / 2;
+	
+	OSAKA_StreamTilemap(&world->tilemap, (Rectangle){ target.x - margin, target.y - margin, SCREEN_WIDTH + margin * 2, SCREEN_HEIGHT + margin * 2 });
+}
+
+// fnv-1a over everything a tick can change, replays compare it tick by tick
+uint64_t worldHash()
+{
+	uint64_t hash = 14695981039346656037ull;
+	
+	#define HASH(value) do { const unsigned char* bytes = (const unsigned char*)&(value); \
+		for (size_t byte = 0; byte < sizeof(value); byte++) { hash ^= bytes[byte]; hash *= 1099511628211ull; } } while (0)
+	
+	for (int i = 0; i < game.aliveEntsLength; i++)
+	{
+		LiveEnt* ent = entAt(&game, game.aliveEnts[i]);
+		int index = ent->index;
+		
+		if (!ent->initialised) continue;
+		
+		HASH(index);
+		HASH(ent->archetype);
+		HASH(ent->facingRight);
+		HASH(ent->onGround);
+		HASH(game.bodies.x[index]);
+		HASH(game.bodies.y[index]);
+		HASH(game.bodies.dx[index]);
+		HASH(game.bodies.dy[index]);
+		HASH(game.bodies.width[index]);
+		HASH(game.bodies.height[index]);
+		HASH(game.bodies.rest[index]);
+	}
+	
+	HASH(game.currentLevel);
+	HASH(game.initLevel);
+	HASH(game.isHard);
+	HASH(viewingStory);
+	HASH(game.selectedRune);
+	
+	#undef HASH
+	
+	return hash;
+}
+
+void render()
+{
+	LiveEnt* followed = getEnt(&game, game.player);
+	
+	if (followed)
+	{
+		// follows where the player is drawn rather than where it is, or the camera would judder against it
+		float alpha = OSAKA_GetInterpolation();
+		int index = followed->index;
+		
+		camera.target = cameraTarget(&game, 
+			game.bodies.prevX[index] + (game.bodies.x[index] - game.bodies.prevX[index]) * alpha + game.bodies.width[index] / 2,
+			game.bodies.prevY[index] + (game.bodies.y[index] - game.bodies.prevY[index]) * alpha + game.bodies.height[index] / 2);
+	}
+	
+	camera.target.x = roundf(camera.target.x);		// whole pixels so tiles do not shimmer at their seams
+	camera.target.y = roundf(camera.target.y);
+	
+	view = (Rectangle){ camera.target.x, camera.target.y, SCREEN_WIDTH, SCREEN_HEIGHT };
+	
+	BeginMode2D(camera);
+	OSAKA_BeginSprites();
+	
+	PROFILE_BEGIN("tilemap");
+	OSAKA_DrawTilemap(&game.tilemap, camera, SCREEN_WIDTH, SCREEN_HEIGHT, tileTextures, LENGTH(tileTextures), LAYER_TILES);
+	PROFILE_END();
+	
+	if (game.currentLevel == 10)
+	{
+		OSAKA_DrawSprite(17, view, WHITE, LAYER_SCREEN, 0);
+	}
+	else if (game.currentLevel == 11)
+	{
+		OSAKA_DrawSprite(viewingStory ? 19 : 18, view, WHITE, LAYER_SCREEN, 0);
+	}
+	
+	// the layers put them back to front, the batch puts each archetype's shared textures together
+	renderSystem(&game, ARCHETYPE_PLATFORM);
+	renderSystem(&game, ARCHETYPE_MONSTER);
+	renderSystem(&game, ARCHETYPE_WIZARD);
+	renderSystem(&game, ARCHETYPE_RUNE);
+	renderSystem(&game, ARCHETYPE_PLAYER);
+	
+	if (game.level.text) OSAKA_DrawText(&levelText, game.level.textX, game.level.textY);
+	
+	PROFILE_BEGIN("sprites");
+	OSAKA_EndSprites();
+	PROFILE_END();
+	
+	EndMode2D();
+	
+	OSAKA_BeginSprites();
+	
+	char buffer[TEXT_CHARACTER_LENGTH];
+	
+	if (game.currentLevel < 10)
+	{
+		if (shownLevel != game.currentLevel)
+		{
+			shownLevel = game.currentLevel;
+			sprintf(buffer, "level %i", game.currentLevel+1);
+			OSAKA_SetText(&levelNumberText, buffer);
+		}
+		
+		OSAKA_DrawText(&levelNumberText, 10, 775);
+	}
+	
+	if (game.currentLevel < 11)
+	{
+		// only moves on a tick, frames in between reuse it
+		if (shownTime != game.atime)
+		{
+			shownTime = game.atime;
+			sprintf(buffer, "time : %.2f", game.atime);
+			OSAKA_SetText(&timeText, buffer);
+		}
+		
+		OSAKA_DrawText(&timeText, 10, 805);
+	}
+	
+	if (IsKeyDown(KEY_F3))
+	{
+		SpriteStats stats = OSAKA_GetSpriteStats();
+		int voices = OSAKA_GetSoundStats().voices;
+		int ahead = (int)(OSAKA_GetMusicStats().ahead * 100) * 10;		// milliseconds the emptiest playing track has decoded, to 10 so the line is not redone every frame
+		
+		if (memcmp(&stats, &shownStats, sizeof(SpriteStats)) || voices != shownVoices || ahead != shownAhead)
+		{
+			shownStats = stats;
+			shownVoices = voices;
+			shownAhead = ahead;
+			sprintf(buffer, "draws : %i  binds : %i  flushes : %i  voices : %i  music : %i ms", stats.draws, stats.binds, stats.flushes, voices, ahead);
+			OSAKA_SetText(&statsText, buffer);
+		}
+		
+		// right aligned, the line grows as the counts do
+		OSAKA_DrawText(&statsText, SCREEN_WIDTH - 10 - OSAKA_MeasureText(&statsText).x, 805);
+	}
+	
+	if (viewingAnalysis){
+		OSAKA_DrawSprite(20, (Rectangle){ 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT }, WHITE, LAYER_OVERLAY, 0);
+	}
+	
+	OSAKA_EndSprites();
+}
+
+void quit()
+{
+	freeWorld(&game);
+	OSAKA_CloseLevelPack(&levelPack);
+	
+	if (profileFileName) OSAKA_SaveProfile(profileFileName);
+}
+
+void headlessInit()
+{
+	init();
+	
+	game.currentLevel = headlessLevel >= 0 ? headlessLevel : 0;
+	game.initLevel = true;
+}
+
+void headlessUpdate()
+{
+	update();
+	
+	headlessRunTicks++;
+	
+	// a run ends when the level does (finished, died or restarted) or when it runs out of ticks
+	if (!game.initLevel && (!headlessTicks || headlessRunTicks < headlessTicks)) return;
+	
+	headlessRunsDone++;
+	headlessRunTicks = 0;
+	
+	if (headlessRunsDone >= headlessRuns)
+	{
+		running = false;
+		return;
+	}
+	
+	game.currentLevel = headlessLevel >= 0 ? headlessLevel : headlessRunsDone % LEVELS_PLAYABLE;
+	game.initLevel = true;
+}
+
+struct HeadlessWorker
+{
+	World world;
+	long long runs;
+	long long ticks;
+};
+
+// a run is the same on any world, so each one takes the next as soon as it is done with its last
+void headlessJob(void* data)
+{
+	HeadlessWorker* worker = data;
+	World* world = &worker->world;
+	
+	while (true)
+	{
+		OSAKA_LockMutex(headlessMutex);
+		long long run = headlessRunsTaken < headlessRuns ? headlessRunsTaken++ : -1;
+		OSAKA_UnlockMutex(headlessMutex);
+		
+		if (run < 0) return;
+		
+		world->currentLevel = headlessLevel >= 0 ? headlessLevel : run % LEVELS_PLAYABLE;
+		world->initLevel = true;
+		
+		long long ticks = 0;
+		
+		// ends like a run through the game does, on the level ending or running out of ticks
+		do
+		{
+			stepWorld(world);
+			ticks++;
+		}
+		while (!world->initLevel && (!headlessTicks || ticks < headlessTicks));
+		
+		worker->runs++;
+		worker->ticks += ticks;
+	}
+}
+
+// every run, spread over one world per thread
+void headlessSweep()
+{
+	int worlds = headlessWorlds > 0 ? headlessWorlds : OSAKA_GetProcessorCount();
+	
+	if (worlds > JOB_POOL_THREADS_LENGTH) worlds = JOB_POOL_THREADS_LENGTH;
+	if (worlds > headlessRuns) worlds = headlessRuns;
+	
+	headlessWorkers = calloc(worlds, sizeof(HeadlessWorker));
+	headlessMutex = OSAKA_CreateMutex();
+	
+	JobPool* pool = headlessWorkers && headlessMutex ? OSAKA_CreateJobPool(worlds) : NULL;
+	
+	if (!pool)
+	{
+		TraceLog(LOG_ERROR, "could not start headless worlds (worlds : %i)", worlds);
+		return;
+	}
+	
+	uint64_t start = OSAKA_GetTimeNanoseconds();
+	
+	headlessWorkersLength = worlds;
+	headlessRunsTaken = 0;
+	
+	for (int i = 0; i < worlds; i++)
+	{
+		initWorld(&headlessWorkers[i].world, false);
+		OSAKA_PushJob(pool, headlessJob, &headlessWorkers[i]);
+	}
+	
+	OSAKA_WaitJobPool(pool);
+	OSAKA_DestroyJobPool(pool);
+	
+	double elapsed = (OSAKA_GetTimeNanoseconds() - start) / 1000000000.0;
+	long long ticks = 0;
+	
+	for (int i = 0; i < worlds; i++)
+	{
+		headlessRunsDone += headlessWorkers[i].runs;
+		ticks += headlessWorkers[i].ticks;
+	}
+	
+	// wall clock, the worlds run at the same time so cpu time would count each second once per thread
+	TraceLog(LOG_INFO, "headless worlds finished (worlds : %i) (ticks : %lld) (seconds : %.3f) (ticks per second : %.0f)",
+		worlds, ticks, elapsed, elapsed > 0 ? ticks / elapsed : 0);
+}
+
+void headlessQuit()
+{
+	long long ticks = OSAKA_GetTickCount();
+	long long deaths = OSAKA_GetSoundPlayCount(4);
+	
+	// worlds off screen keep their own counts since they never play anything
+	if (headlessWorkers)
+	{
+		ticks = deaths = 0;
+		
+		for (int i = 0; i < headlessWorkersLength; i++)
+		{
+			ticks += headlessWorkers[i].ticks;
+			deaths += headlessWorkers[i].world.soundPlays[4];
+			freeWorld(&headlessWorkers[i].world);
+		}
+	}
+	
+	free(headlessWorkers);
+	OSAKA_DestroyMutex(headlessMutex);
+	headlessWorkers = NULL;
+	headlessMutex = NULL;
+	
+	TraceLog(LOG_INFO, "headless runs finished (runs : %lld) (ticks : %lld) (death sounds : %lld)", headlessRunsDone, ticks, deaths);
+	
+	quit();
+}
+
+// bench ---------------------------------------------------------------------------------------------------------------
+
+// a comma separated list of entity counts, one synthetic world each
+bool parseBenchEnts(char* list)
+{
+	benchEntsLength = 0;
+	
+	for (char* count = strtok(list, ","); count; count = strtok(NULL, ","))
+	{
+		if (benchEntsLength >= BENCH_CONFIGS_LENGTH || atoi(count) < 1)
+		{
+			TraceLog(LOG_ERROR, "could not read bench entity counts, expected up to %i positive counts (count : %s)", BENCH_CONFIGS_LENGTH, count);
+			return false;
+		}
+		
+		benchEnts[benchEntsLength++] = atoi(count);
+	}
+	
+	return benchEntsLength > 0;
+}
+
+// xorshift, the bench has to build the same world from the same seed on every platform
+uint benchRandomRange(uint range)
+{
+	benchRandom ^= benchRandom << 13;
+	benchRandom ^= benchRandom >> 7;
+	benchRandom ^= benchRandom << 17;
+	
+	return (uint)(benchRandom >> 32) % range;
+}
+
+// a floor, benchTiles percent of the cells above it solid and the mix scattered over the whole world
+void benchBuild()
+{
+	benchRandom = (benchSeed + 1) * 0x9E3779B97F4A7C15ull + benchConfig;
+	
+	clearEnts(&game);
+	
+	game.player = game.wizard = game.selectedRune = (EntHandle){0};
+	game.currentLevel = 0;
+	game.initLevel = false;
+	game.levelIndex = -1;
+	
+	OSAKA_FreeTilemap(&game.tilemap);
+	
+	if (!OSAKA_InitTilemap(&game.tilemap, benchGridWidth, benchGridHeight, TILE_SIZE, NULL)) return;
+	
+	for (int y = 0; y < benchGridHeight; y++)
+	{
+		for (int x = 0; x < benchGridWidth; x++)
+		{
+			if (y == benchGridHeight - 1 || (int)benchRandomRange(100) < benchTiles) OSAKA_SetTile(&game.tilemap, x, y, 1);
+		}
+	}
+	
+	int ents = benchEnts[benchConfig];
+	int weights = benchMix[0] + benchMix[1] + benchMix[2];
+	int monsters = (long long)ents * benchMix[0] / weights;
+	int platforms = ents - monsters - (int)((long long)ents * benchMix[1] / weights);
+	int floor = (benchGridHeight - 1) * TILE_SIZE;
+	int right = benchGridWidth * TILE_SIZE;
+	
+	benchRunes = ents - monsters - platforms;
+	
+	for (int i = 0; i < monsters; i++)
+	{
+		int size = 32 + benchRandomRange(64);
+		LiveEnt* monster = getEnt(&game, createMonster(&game, benchRandomRange(right - size), benchRandomRange(floor - size), size, size));
+		
+		if (monster) monster->facingRight = benchRandomRange(2);
+	}
+	
+	for (int i = 0; i < platforms; i++)
+	{
+		int width = 64 + benchRandomRange(64);
+		
+		createPlatform(&game, benchRandomRange(right - width), benchRandomRange(floor - TILE_SIZE), width, TILE_SIZE);
+	}
+	
+	// unscaled runes so hits use them up without growing or shrinking anything, the world keeps its shape however long it runs
+	for (int i = 0; i < benchRunes; i++)
+	{
+		createItem(&game, benchRandomRange(right - TILE_SIZE/2), benchRandomRange(floor - TILE_SIZE/2), 1, 1);
+	}
+	
+	for (int i = 0; i < game.aliveEntsLength; i++)
+	{
+		broadphaseSync(&game, entAt(&game, game.aliveEnts[i]));
+	}
+	
+	benchTick = -BENCH_WARMUP_TICKS;
+	benchEntTicks = 0;
+}
+
+// each rune is thrown again every benchThrow ticks, staggered so the same few are in the air each tick
+void benchThrowRunes()
+{
+	int* runes = game.archetypeEnts[ARCHETYPE_RUNE];
+	
+	if (benchThrow <= 0) return;
+	
+	for (int i = 0; i < game.archetypeEntsLength[ARCHETYPE_RUNE]; i++)
+	{
+		if ((i + benchTick) % benchThrow) continue;
+		
+		int index = runes[i];
+		
+		game.bodies.fx[index] = impulse(benchRandomRange(2) ? 2500 : -2500);
+		game.bodies.fy[index] = impulse(-3000);
+	}
+}
+
+int compareTimes(const void* a, const void* b)
+{
+	ullong timeA = *(const ullong*)a;
+	ullong timeB = *(const ullong*)b;
+	
+	return (timeA > timeB) - (timeA < timeB);
+}
+
+// one json object per line on stdout, raylib logs there too so only errors are let through while benching
+void benchReport()
+{
+	ullong total = 0;
+	
+	for (long long i = 0; i < benchTicks; i++)
+	{
+		total += benchTimes[i];
+	}
+	
+	qsort(benchTimes, benchTicks, sizeof(ullong), compareTimes);
+	
+	int asleep = 0;
+	
+	for (int i = 0; i < game.aliveEntsLength; i++)
+	{
+		if (isAsleep(&game, entAt(&game, game.aliveEnts[i]))) asleep++;
+	}
+	
+	printf("{\"ents\":%i,\"mix\":[%i,%i,%i],\"tiles\":%i,\"grid\":[%i,%i],\"throw\":%i,\"seed\":%u,\"ticks\":%lld,"
+		"\"ticksPerSecond\":%.1f,\"nsPerEntTick\":%.2f,\"p50Us\":%.2f,\"p90Us\":%.2f,\"p99Us\":%.2f,\"maxUs\":%.2f,\"endEnts\":%i,\"endAsleep\":%i}\n",
+		benchEnts[benchConfig], benchMix[0], benchMix[1], benchMix[2], benchTiles, benchGridWidth, benchGridHeight, benchThrow, benchSeed, benchTicks,
+		total ? benchTicks * 1e9 / total : 0, benchEntTicks ? total / benchEntTicks : 0,
+		benchTimes[(benchTicks - 1) * 50 / 100] / 1000.0, benchTimes[(benchTicks - 1) * 90 / 100] / 1000.0,
+		benchTimes[(benchTicks - 1) * 99 / 100] / 1000.0, benchTimes[benchTicks - 1] / 1000.0, game.aliveEntsLength, asleep);
+	
+	fflush(stdout);
+}
+
+void benchInit()
+{
+	SetTraceLogLevel(LOG_ERROR);
+	
+	init();
+	
+	benchTimes = malloc(benchTicks * sizeof(ullong));
+	
+	if (!benchTimes)
+	{
+		TraceLog(LOG_ERROR, "could not allocate bench tick times (ticks : %lld)", benchTicks);
+		running = false;
+		return;
+	}
+	
+	benchConfig = 0;
+	benchBuild();
+}
+
+// only simulate() is timed, throwing and topping up runes is the bench's own work
+void benchUpdate()
+{
+	if (!benchTimes)
+	{
+		running = false;
+		return;
+	}
+	
+	benchThrowRunes();
+	
+	ullong start = OSAKA_GetTimeNanoseconds();
+	simulate(&game);
+	ullong time = OSAKA_GetTimeNanoseconds() - start;
+	
+	int floor = (benchGridHeight - 1) * TILE_SIZE;
+	
+	while (game.archetypeEntsLength[ARCHETYPE_RUNE] < benchRunes)
+	{
+		LiveEnt* rune = getEnt(&game, createItem(&game, benchRandomRange(benchGridWidth*TILE_SIZE - TILE_SIZE/2), benchRandomRange(floor - TILE_SIZE/2), 1, 1));
+		
+		if (!rune) break;
+		
+		broadphaseSync(&game, rune);
+	}
+	
+	if (benchTick >= 0)
+	{
+		benchTimes[benchTick] = time;
+		benchEntTicks += game.aliveEntsLength;
+	}
+	
+	if (++benchTick < benchTicks) return;
+	
+	benchReport();
+	
+	if (++benchConfig >= benchEntsLength)
+	{
+		running = false;
+		return;
+	}
+	
+	benchBuild();
+}
+
+void benchQuit()
+{
+	free(benchTimes);
+	benchTimes = NULL;
+	
+	quit();
+}
+
+// check ---------------------------------------------------------------------------------------------------------------
+
+#define CHECK_TICK_RATES_LENGTH 3
+#define JUMP_TOLERANCE 0.01f		// of the height at the base tick rate, integrating in smaller steps moves it a little
+
+const int checkTickRates[CHECK_TICK_RATES_LENGTH] = { 30, 120, 240 };
+
+// the highest the player gets from one jump off a bare floor at tickRate, pixels
+float jumpHeight(int tickRate)
+{
+	World world;
+	
+	OSAKA_SetTickRate(tickRate);
+	initWorld(&world, false);
+	OSAKA_InitTilemap(&world.tilemap, GRID_WIDTH, GRID_HEIGHT, TILE_SIZE, NULL);
+	
+	for (int x = 0; x < GRID_WIDTH; x++)
+	{
+		OSAKA_SetTile(&world.tilemap, x, GRID_HEIGHT - 1, 1);
+	}
+	
+	world.player = createPlayer(&world, TILE_SIZE * 2, (GRID_HEIGHT - 1) * TILE_SIZE - 50, 50, 50);
+	flushEnts(&world);
+	
+	LiveEnt* player = getEnt(&world, world.player);
+	
+	// a second to land and settle, then three to go up and come back down
+	for (int i = 0; i < tickRate; i++)
+	{
+		simulate(&world);
+	}
+	
+	float ground = world.bodies.y[player->index];
+	float top = ground;
+	
+	jump(&world, player);
+	
+	for (int i = 0; i < tickRate * 3; i++)
+	{
+		simulate(&world);
+		
+		if (world.bodies.y[player->index] < top) top = world.bodies.y[player->index];
+	}
+	
+	freeWorld(&world);
+	
+	return ground - top;
+}
+
+// --check-jumps, a jump has to go as high whatever the tick rate, or levels would play differently on it
+bool checkJumps()
+{
+	int tickRate = OSAKA_GetTickRate();
+	float base = jumpHeight(BASE_TICK_RATE);
+	bool passed = base > 0;
+	
+	TraceLog(LOG_INFO, "jump height (tick rate : %i) (height : %.2f)", BASE_TICK_RATE, base);
+	
+	for (int i = 0; i < CHECK_TICK_RATES_LENGTH; i++)
+	{
+		float height = jumpHeight(checkTickRates[i]);
+		
+		if (fabsf(height - base) > base * JUMP_TOLERANCE)
+		{
+			TraceLog(LOG_ERROR, "jump height depends on the tick rate (tick rate : %i) (height : %.2f) (base height : %.2f)", checkTickRates[i], height, base);
+			passed = false;
+		}
+		else TraceLog(LOG_INFO, "jump height (tick rate : %i) (height : %.2f)", checkTickRates[i], height);
+	}
+	
+	OSAKA_SetTickRate(tickRate);
+	
+	return passed;
+}